@@ -110,7 +110,7 @@ void initMask() {
 #ifndef WITH_MAGIC // then use HQBB
 
 BitBoard attack(const BitBoard occupancy, const Square x, const BitBoard m) {
-    START_TIMER
+    START_TIMER(Attack)
     BitBoard forward = occupancy & m;
     BitBoard reverse = swapbits(forward);
     forward -= SquareToBitboard(x);
@@ -233,12 +233,21 @@ BitBoard allAttackedBB(const Position &p, const Square x) {
 } // BBTools
 
 bool isAttacked(const Position & p, const Square k) {
-    START_TIMER
+    START_TIMER(IsAttacked)
     const bool b = k!=INVALIDSQUARE && BBTools::isAttackedBB(p, k, p.c);
     STOP_AND_SUM_TIMER(IsAttacked);
     return b;
 }
 
+BitBoard getPinned(const Position & p, Color C, const Square s){
+    BitBoard pinned = emptyBitBoard;
+    if ( s == INVALIDSQUARE ) return pinned;
+    BitBoard pinner = BBTools::attack<P_wb>(s, p.pieces_const<P_wb>(~C) | p.pieces_const<P_wq>(~C), p.allPieces[~C]) 
+                    | BBTools::attack<P_wr>(s, p.pieces_const<P_wr>(~C) | p.pieces_const<P_wq>(~C), p.allPieces[~C]);
+    while ( pinner ) { pinned |= BBTools::mask[popBit(pinner)].between[p.king[C]] & p.allPieces[C]; }
+    return pinned;
+}
+
 bool isAttacked(const Position & p, BitBoard bb) { // copy ///@todo should be done without iterate over Square !
     while ( bb ) if ( isAttacked(p, Square(popBit(bb)))) return true;
     return false;
@@ -123,3 +123,6 @@ constexpr BitBoard(*const pfCoverage[])(const Square, const BitBoard, const Colo
 // Those are wrapper functions around isAttackedBB
 [[nodiscard]] bool isAttacked(const Position & p, const Square k);
 [[nodiscard]] bool isAttacked(const Position & p, BitBoard bb);
+
+// Pieces of color C pinned on square s (most often its king) by opponent sliders
+[[nodiscard]] BitBoard getPinned(const Position & p, Color C, const Square s);
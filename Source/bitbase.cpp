@@ -0,0 +1,293 @@
+#include "bitbase.hpp"
+
+#include "attack.hpp"
+#include "kpk.hpp"
+#include "logging.hpp"
+#include "position.hpp"
+
+#include "bitbaseData.hpp"
+
+namespace{
+
+// All bitbases are seen from the strong side point of view : strong side is white (moving up)
+// and pawn is always on the queen side (file a to d).
+struct Domain{
+    Piece x;                      // the strong side piece
+    bool strongPawn;              // does the pawn belong to the strong side
+    bool darkX;                   // strong piece is restricted to dark squares (wrong bishop)
+    std::vector<Square> pawnSq;   // pawn squares inside the domain
+    [[nodiscard]] inline int nbX()const{ return darkX ? 32 : 64; }
+    [[nodiscard]] inline size_t size()const{ return 2 * pawnSq.size() * NbSquare * NbSquare * nbX(); }
+    [[nodiscard]] inline int pawnIndex(Square p)const{ for (size_t k = 0 ; k < pawnSq.size() ; ++k) if (pawnSq[k] == p) return int(k); return -1; }
+};
+
+const Domain domainKQKP = { P_wq, false, false, {Sq_a2,Sq_b2,Sq_c2,Sq_d2} };
+const Domain domainKRKP = { P_wr, false, false, {Sq_a2,Sq_b2,Sq_c2,Sq_d2,Sq_a3,Sq_b3,Sq_c3,Sq_d3} };
+const Domain domainKBPK = { P_wb, true,  true,  {Sq_a2,Sq_a3,Sq_a4,Sq_a5,Sq_a6,Sq_a7} };
+
+// x and p are INVALIDSQUARE once captured, promo is the type of a promoted pawn (standing on p)
+struct BBPos{
+    Color stm;
+    Square sk, wk, x, p;
+    Piece promo;
+};
+
+[[nodiscard]] inline size_t bbIndex(const Domain & d, Color stm, int pIdx, Square sk, Square wk, Square x){
+    return (((size_t(stm) * d.pawnSq.size() + pIdx) * NbSquare + sk) * NbSquare + wk) * d.nbX() + (d.darkX ? (x>>1) : x);
+}
+
+[[nodiscard]] inline bool probeData(const uint64_t * data, size_t idx){ return (data[idx/64] >> (idx&63)) & 1ull; }
+
+enum GenResult : unsigned char { gr_invalid = 0, gr_unknown, gr_draw, gr_win };
+
+// The solver is used offline by the generator (retrograde analysis until convergence, db is filled)
+// and at probe time when the strong side is to move (only weak side to move data are embedded, so one ply is needed).
+struct Solver{
+    const Domain & d;
+    const uint32_t * kpk;        // used when the bishop is captured
+    const uint64_t * data;       // embedded data (probe mode)
+    std::vector<GenResult> db;   // generation mode
+
+    Solver(const Domain & dd, const uint32_t * kpkData, const uint64_t * embedded = nullptr): d(dd), kpk(kpkData), data(embedded), db(embedded ? 0 : dd.size(), gr_invalid){}
+
+    [[nodiscard]] BBPos decode(size_t idx)const{
+        BBPos s;
+        const Square xi = Square(idx % d.nbX()); idx /= d.nbX();
+        s.x  = d.darkX ? Square(2*xi + ((xi/4)&1)) : xi; // dark squares are a1,c1,...,b2,d2,...
+        s.wk = Square(idx % NbSquare); idx /= NbSquare;
+        s.sk = Square(idx % NbSquare); idx /= NbSquare;
+        s.p  = d.pawnSq[idx % d.pawnSq.size()]; idx /= d.pawnSq.size();
+        s.stm = Color(idx);
+        s.promo = P_none;
+        return s;
+    }
+
+    [[nodiscard]] BitBoard occupancy(const BBPos & s)const{
+        BitBoard b = SquareToBitboard(s.sk) | SquareToBitboard(s.wk);
+        if ( s.x != INVALIDSQUARE ) b |= SquareToBitboard(s.x);
+        if ( s.p != INVALIDSQUARE ) b |= SquareToBitboard(s.p);
+        return b;
+    }
+
+    [[nodiscard]] BitBoard pawnCoverage(const BBPos & s, BitBoard occ, Color c)const{
+        return s.promo != P_none ? BBTools::pfCoverage[s.promo-1](s.p, occ, c) : BBTools::mask[s.p].pawnAttack[c];
+    }
+
+    [[nodiscard]] BitBoard strongCoverage(const BBPos & s, BitBoard occ)const{
+        BitBoard b = BBTools::mask[s.sk].king;
+        if ( s.x != INVALIDSQUARE ) b |= BBTools::pfCoverage[d.x-1](s.x, occ, Co_White);
+        if ( d.strongPawn && s.p != INVALIDSQUARE ) b |= pawnCoverage(s, occ, Co_White);
+        return b;
+    }
+
+    [[nodiscard]] BitBoard weakCoverage(const BBPos & s, BitBoard occ)const{
+        BitBoard b = BBTools::mask[s.wk].king;
+        if ( !d.strongPawn && s.p != INVALIDSQUARE ) b |= pawnCoverage(s, occ, Co_Black);
+        return b;
+    }
+
+    // side that has just played cannot be in check
+    [[nodiscard]] bool isLegal(const BBPos & s)const{
+        const BitBoard occ = occupancy(s);
+        if ( s.stm == Co_White ) return !(strongCoverage(s, occ) & SquareToBitboard(s.wk));
+        return !(weakCoverage(s, occ) & SquareToBitboard(s.sk));
+    }
+
+    [[nodiscard]] bool isInCheck(const BBPos & s)const{
+        const BitBoard occ = occupancy(s);
+        if ( s.stm == Co_White ) return weakCoverage(s, occ) & SquareToBitboard(s.sk);
+        return strongCoverage(s, occ) & SquareToBitboard(s.wk);
+    }
+
+    // weak side has only its king and is to move, strong side wins if it cannot capture the essential piece and is not stalemated
+    [[nodiscard]] GenResult bareKing(const BBPos & s, Square essential)const{
+        const BitBoard occ = occupancy(s);
+        BitBoard moves = BBTools::mask[s.wk].king & ~strongCoverage(s, occ & ~SquareToBitboard(s.wk));
+        if ( moves & SquareToBitboard(essential) ) return gr_draw;
+        if ( moves ) return gr_win;
+        return (strongCoverage(s, occ) & SquareToBitboard(s.wk)) ? gr_win : gr_draw; // mate or stalemate
+    }
+
+    // call f on every pseudo-legal move (the promoted piece of the weak side is only moved by the tactical search)
+    template<typename F> void forEachMove(const BBPos & s, F f)const{
+        const BitBoard occ = occupancy(s);
+        if ( s.stm == Co_White ){
+            const BitBoard own = SquareToBitboard(s.sk) | (s.x != INVALIDSQUARE ? SquareToBitboard(s.x) : emptyBitBoard) | (d.strongPawn ? SquareToBitboard(s.p) : emptyBitBoard);
+            auto capture = [&](BBPos & c, Square to){ if ( to == s.p ){ c.p = INVALIDSQUARE; c.promo = P_none; } };
+            BitBoard b = BBTools::mask[s.sk].king & ~own;
+            while (b){ BBPos c = s; c.stm = Co_Black; c.sk = Square(popBit(b)); capture(c,c.sk); f(c); }
+            if ( s.x != INVALIDSQUARE ){
+               b = BBTools::pfCoverage[d.x-1](s.x, occ, Co_White) & ~own & ~SquareToBitboard(s.wk);
+               while (b){ BBPos c = s; c.stm = Co_Black; c.x = Square(popBit(b)); capture(c,c.x); f(c); }
+            }
+            if ( d.strongPawn ){
+                const Square to = s.p + 8;
+                if ( !(occ & SquareToBitboard(to)) ){
+                    if ( SQRANK(to) == Rank_8 ){ for (Piece pp : {P_wq, P_wr}){ BBPos c = s; c.stm = Co_Black; c.p = to; c.promo = pp; f(c); } }
+                    else{ BBPos c = s; c.stm = Co_Black; c.p = to; f(c); }
+                    if ( SQRANK(s.p) == Rank_2 && !(occ & SquareToBitboard(to+8)) ){ BBPos c = s; c.stm = Co_Black; c.p = to+8; f(c); }
+                }
+            }
+        }
+        else{
+            BitBoard b = BBTools::mask[s.wk].king & ~(d.strongPawn || s.p == INVALIDSQUARE ? emptyBitBoard : SquareToBitboard(s.p));
+            while (b){ BBPos c = s; c.stm = Co_White; c.wk = Square(popBit(b)); if ( c.wk == s.x ) c.x = INVALIDSQUARE; if ( d.strongPawn && c.wk == s.p ) c.p = INVALIDSQUARE; f(c); }
+            if ( !d.strongPawn && s.p != INVALIDSQUARE ){
+                if ( s.promo != P_none ){
+                    b = BBTools::pfCoverage[s.promo-1](s.p, occ, Co_Black) & ~SquareToBitboard(s.wk) & ~SquareToBitboard(s.sk);
+                    while (b){ BBPos c = s; c.stm = Co_White; c.p = Square(popBit(b)); if ( c.p == s.x ) c.x = INVALIDSQUARE; f(c); }
+                    return;
+                }
+                const Square to = s.p - 8;
+                if ( !(occ & SquareToBitboard(to)) ){
+                    if ( SQRANK(to) == Rank_1 ){ for (Piece pp : {P_wq, P_wr, P_wb, P_wn}){ BBPos c = s; c.stm = Co_White; c.p = to; c.promo = pp; f(c); } }
+                    else{ BBPos c = s; c.stm = Co_White; c.p = to; f(c); }
+                }
+                if ( s.x != INVALIDSQUARE && (BBTools::mask[s.p].pawnAttack[Co_Black] & SquareToBitboard(s.x)) ){ BBPos c = s; c.stm = Co_White; c.p = s.x; c.x = INVALIDSQUARE; f(c); }
+            }
+        }
+    }
+
+    // strong side to move against a promoted piece : look for a quick win using only checks and the capture of the promoted piece
+    [[nodiscard]] bool quickWin(const BBPos & s, int depth)const{
+        bool win = false;
+        forEachMove(s, [&](const BBPos & c){
+            if ( win || !isLegal(c) ) return;
+            if ( c.p == INVALIDSQUARE ){ win = bareKing(c, c.x) == gr_win; return; }
+            if ( !isInCheck(c) ) return;
+            bool hasReply = false, allLose = true;
+            forEachMove(c, [&](const BBPos & w){
+                if ( !allLose || !isLegal(w) ) return;
+                hasReply = true;
+                allLose = w.x != INVALIDSQUARE && depth > 1 && quickWin(w, depth-1);
+            });
+            win = !hasReply || allLose; // mate, or every answer loses
+        });
+        return win;
+    }
+
+    // weak pawn has just promoted, strong side to move
+    // only a forced win found by the tactical search is trusted, everything else is "not a proven win"
+    [[nodiscard]] GenResult afterWeakPromotion(const BBPos & s)const{
+        return quickWin(s, 2) ? gr_win : gr_draw;
+    }
+
+    // value of a position reached after a move, outside the domain
+    [[nodiscard]] GenResult exitValue(const BBPos & s)const{
+        if ( !d.strongPawn ){
+            if ( s.x == INVALIDSQUARE ) return gr_draw;                // only the strong king remains
+            if ( s.p == INVALIDSQUARE ) return bareKing(s, s.x);       // KXK
+            return afterWeakPromotion(s);
+        }
+        if ( s.p == INVALIDSQUARE ) return gr_draw;                    // KBK
+        if ( s.x == INVALIDSQUARE ){                                   // KPK, strong side to move
+            const unsigned idx = KPK::index(Co_White, s.wk, s.sk, s.p);
+            return (kpk[idx/32] & (1u<<(idx&0x1F))) ? gr_win : gr_draw;
+        }
+        return bareKing(s, s.p);                                       // KBQK or KBRK
+    }
+
+    [[nodiscard]] GenResult childValue(const BBPos & c)const{
+        if ( !isLegal(c) ) return gr_invalid;
+        if ( c.x != INVALIDSQUARE && c.p != INVALIDSQUARE && c.promo == P_none ){
+            const int pIdx = d.pawnIndex(c.p);
+            if ( pIdx >= 0 ){
+                if ( data ) return probeData(data, bbIndex(d, Co_White, pIdx, c.sk, c.wk, c.x)) ? gr_win : gr_draw; // always weak side to move here
+                return db[bbIndex(d, c.stm, pIdx, c.sk, c.wk, c.x)];
+            }
+        }
+        return exitValue(c);
+    }
+
+    [[nodiscard]] GenResult compute(const BBPos & s)const{
+        const GenResult good = s.stm == Co_White ? gr_win  : gr_draw;
+        const GenResult bad  = s.stm == Co_White ? gr_draw : gr_win;
+        bool hasMove = false, hasUnknown = false, hasGood = false;
+        forEachMove(s, [&](const BBPos & c){ 
+            if ( hasGood ) return;
+            const GenResult r = childValue(c);
+            if ( r == gr_invalid ) return;
+            hasMove = true; hasUnknown |= r == gr_unknown; hasGood |= r == good; 
+        });
+        if ( !hasMove ) return s.stm == Co_Black && isInCheck(s) ? gr_win : gr_draw; // weak side is mated, otherwise stalemate (or strong side mated)
+        return hasGood ? good : hasUnknown ? gr_unknown : bad;
+    }
+
+    void run(){
+        for (size_t idx = 0; idx < db.size(); ++idx){
+            const BBPos s = decode(idx);
+            const bool distinct = s.sk != s.wk && s.sk != s.x && s.sk != s.p && s.wk != s.x && s.wk != s.p && s.x != s.p;
+            db[idx] = distinct && chebyshevDistance(s.sk,s.wk) > 1 && isLegal(s) ? gr_unknown : gr_invalid;
+        }
+        bool repeat = true;
+        while (repeat){
+            repeat = false;
+            for (size_t idx = 0; idx < db.size(); ++idx){
+                if ( db[idx] != gr_unknown ) continue;
+                const GenResult r = compute(decode(idx));
+                if ( r != gr_unknown ){ db[idx] = r; repeat = true; }
+            }
+        }
+    }
+
+    // only weak side to move half is written
+    void write(std::ofstream & str, const std::string & name)const{
+        const size_t half = db.size()/2;
+        std::vector<uint64_t> bits((half+63)/64, 0ull);
+        size_t nbWin = 0;
+        for (size_t idx = 0; idx < half; ++idx) if ( db[half+idx] == gr_win ){ bits[idx/64] |= 1ull << (idx&63); ++nbWin; }
+        Logging::LogIt(Logging::logInfo) << name << " : " << half << " positions, " << nbWin << " wins";
+        str << "inline constexpr uint64_t " << name << "[" << bits.size() << "] = {";
+        for (size_t k = 0; k < bits.size(); ++k) str << (k%8 ? " " : "\n") << "0x" << std::hex << bits[k] << std::dec << "ull,";
+        str << "\n};\n\n";
+    }
+};
+
+// normalize squares to the strong side point of view and probe the embedded data
+// "not win" is only an exact draw when the weak side has a bare king, otherwise the weak side may win or be better
+Bitbase::BitbaseResult probe(const Domain & d, const uint64_t * data, const Position & p, Color strongSide){
+    const Bitbase::BitbaseResult notWin = d.strongPawn ? Bitbase::bb_draw : Bitbase::bb_unknown;
+    const Color pawnSide = d.strongPawn ? strongSide : ~strongSide;
+    BBPos s;
+    s.sk = p.king[strongSide]; s.wk = p.king[~strongSide];
+    s.x  = BBTools::SquareFromBitBoard(p.pieces_const(strongSide,d.x));
+    s.p  = BBTools::SquareFromBitBoard(p.pieces_const<P_wp>(pawnSide));
+    s.stm = p.c == strongSide ? Co_White : Co_Black;
+    s.promo = P_none;
+    if ( strongSide == Co_Black ){ s.sk = VFlip(s.sk); s.wk = VFlip(s.wk); s.x = VFlip(s.x); s.p = VFlip(s.p); }
+    if ( SQFILE(s.p) > File_d ){ s.sk = HFlip(s.sk); s.wk = HFlip(s.wk); s.x = HFlip(s.x); s.p = HFlip(s.p); }
+    const int pIdx = d.pawnIndex(s.p);
+    if ( pIdx < 0 || (d.darkX && !(SquareToBitboard(s.x) & blackSquare)) ) return Bitbase::bb_unknown;
+    if ( s.stm == Co_Black ) return probeData(data, bbIndex(d, Co_White, pIdx, s.sk, s.wk, s.x)) ? Bitbase::bb_win : notWin;
+    return Solver(d, BitbaseData::KPK, data).compute(s) == gr_win ? Bitbase::bb_win : notWin;
+}
+
+} // anonymous
+
+namespace Bitbase{
+
+BitbaseResult probeKQKP(const Position & p, Color strongSide){ return probe(domainKQKP, BitbaseData::KQKP, p, strongSide); }
+BitbaseResult probeKRKP(const Position & p, Color strongSide){ return probe(domainKRKP, BitbaseData::KRKP, p, strongSide); }
+BitbaseResult probeKBPK(const Position & p, Color strongSide){ return probe(domainKBPK, BitbaseData::KBPK, p, strongSide); }
+
+void generate(const std::string & fileName){
+    std::ofstream str(fileName);
+    if ( !str ){ Logging::LogIt(Logging::logError) << "Cannot open " << fileName; return; }
+    str << "#pragma once\n\n// Generated by Bitbase::generate (\"-genBitbases\" command line), do not edit\n\nnamespace BitbaseData{\n\n";
+    std::vector<uint32_t> kpk;
+    KPK::generate(kpk);
+    Logging::LogIt(Logging::logInfo) << "KPK : " << kpk.size()*32 << " positions";
+    str << "inline constexpr uint32_t KPK[" << kpk.size() << "] = {";
+    for (size_t k = 0; k < kpk.size(); ++k) str << (k%8 ? " " : "\n") << "0x" << std::hex << kpk[k] << std::dec << "u,";
+    str << "\n};\n\n";
+    const std::vector<std::pair<const Domain*,std::string>> todo = { {&domainKQKP,"KQKP"}, {&domainKRKP,"KRKP"}, {&domainKBPK,"KBPK"} };
+    for (const auto & t : todo){
+        Logging::LogIt(Logging::logInfo) << "Generating " << t.second;
+        Solver g(*t.first, kpk.data());
+        g.run();
+        g.write(str, t.second);
+    }
+    str << "} // BitbaseData\n";
+}
+
+} // Bitbase
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "definition.hpp"
+
+struct Position;
+
+/*!
+ * Small endgame bitbases (win/not win for the strong side)
+ * Data are generated offline (see generate, available using "-genBitbases" command line)
+ * and embedded inside the binary (bitbaseData.hpp), so nothing is computed at startup.
+ * Only weak side to move positions are stored, when strong side is to move one ply is searched.
+ *
+ * To keep them compact, only the difficult part of each endgame is stored :
+ *  - KQKP : pawn on its 7th rank
+ *  - KRKP : pawn on its 6th or 7th rank
+ *  - KBPK : rook pawn with the wrong colored bishop
+ * Outside this domain, probe functions return bb_unknown.
+ *
+ * Only wins are exact : after a weak side promotion, a win is only recorded if a short tactical search proves it.
+ * For KQKP and KRKP "not win" is returned as bb_unknown (the pawn side may draw, be better or even win),
+ * for KBPK the weak side has a bare king so "not win" is an exact draw.
+ */
+namespace Bitbase{
+
+enum BitbaseResult : unsigned char { bb_unknown = 0, bb_draw, bb_win };
+
+[[nodiscard]] BitbaseResult probeKQKP(const Position & p, Color strongSide);
+[[nodiscard]] BitbaseResult probeKRKP(const Position & p, Color strongSide);
+[[nodiscard]] BitbaseResult probeKBPK(const Position & p, Color strongSide);
+
+// write a new bitbaseData.hpp file
+void generate(const std::string & fileName);
+
+} // Bitbase
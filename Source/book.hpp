@@ -0,0 +1,23 @@
+#pragma once
+
+#include "definition.hpp"
+
+struct Position;
+
+/*!
+ * Polyglot opening book (.bin) support
+ * The book file is memory mapped (when possible) and probed using a binary search on Polyglot keys.
+ * Book moves are played directly by COM, without waking the search threads.
+ */
+namespace Book {
+
+// (re)load DynamicConfig::bookFile, an empty name unloads the book
+void init();
+
+// Polyglot Zobrist key of the position (not the Minic one, see Position::h)
+[[nodiscard]] Hash polyglotHash(const Position & p);
+
+// returns INVALIDMOVE if position is not in book, otherwise a legal move (weighted random or best weight if DynamicConfig::bookBestMove)
+[[nodiscard]] Move probe(const Position & p);
+
+} // Book
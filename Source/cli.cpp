@@ -2,16 +2,23 @@
 
 #include "cli.hpp"
 
+#include "bitbase.hpp"
+#include "book.hpp"
 #include "evalDef.hpp"
 #include "logging.hpp"
 #include "searcher.hpp"
 #include "timeMan.hpp"
 #include "tools.hpp"
 #include "tables.hpp"
+#include "taskPool.hpp"
 #include "transposition.hpp"
 #include "uci.hpp"
 #include "xboard.hpp"
 
+#ifdef WITH_DATA2BIN
+#include "learn/learn_tools.hpp"
+#endif
+
 void help(){
 
 }
@@ -76,12 +83,35 @@ Counter perft(const Position & p, DepthType depth, PerftAccumulator & acc){
     return acc.validNodes;
 }
 
+// root moves are shared between task pool threads
+Counter perftParallel(const Position & p, DepthType depth, PerftAccumulator & acc){
+    if ( depth < 2 || DynamicConfig::threads < 2 ) return perft(p,depth,acc);
+    MoveList moves;
+    MoveGen::generate<MoveGen::GP_all>(p,moves);
+    auto worker = [&](size_t begin, size_t end){
+        PerftAccumulator accLoc;
+        for (size_t k = begin ; k < end; ++k){
+            Position p2 = p;
+#if defined(WITH_NNUE) && defined(DEBUG_NNUE_UPDATE)
+            NNUEEvaluator evaluator;
+            p2.associateEvaluator(evaluator);
+            p2.resetNNUEEvaluator(p2.Evaluator());
+#endif
+            if ( ! applyMove(p2,moves[k]) ) continue;
+            perft(p2,depth-1,accLoc);
+        }
+        return accLoc;
+    };
+    acc += TaskPool::instance().parallel_reduce(moves.size(), PerftAccumulator(), worker, [](PerftAccumulator a, const PerftAccumulator & b){ return a += b; }, DynamicConfig::threads, 1);
+    return acc.validNodes;
+}
+
 void perft_test(const std::string & fen, DepthType d, unsigned long long int expected) {
     Position p;
     readFEN(fen, p);
     Logging::LogIt(Logging::logInfo) << ToString(p) ;
     PerftAccumulator acc;
-    unsigned long long int n = perft(p, d, acc);
+    unsigned long long int n = perftParallel(p, d, acc);
     acc.Display();
     if (n != expected) Logging::LogIt(Logging::logFatal) << "Error !! " << fen << " " << expected ;
     Logging::LogIt(Logging::logInfo) << "#########################" ;
@@ -150,6 +180,97 @@ void selfPlay(DepthType depth){
     }    
 }
 
+#ifdef WITH_NNUE
+// replace the value of the EPD opcode "ce" if any, else append it
+void setEPDScore(std::string & line, ScoreType score){
+    const std::string opcode = "ce " + std::to_string(score) + ";";
+    const size_t pos = line.find(" ce ");
+    const size_t end = pos == std::string::npos ? pos : line.find(';', pos);
+    if ( end == std::string::npos ) line += " " + opcode;
+    else line.replace(pos+1, end - pos, opcode);
+}
+
+// NNUE scoring (no search) of all positions of an EPD file (the " ce score;" opcode is set on each line)
+// or of a binary sfen file (score is replaced), using all cores.
+// Files are processed by chunks so that huge data sets can be handled
+int nnueScore(const std::string & input, const std::string & output){
+    if ( !DynamicConfig::useNNUE ){
+        Logging::LogIt(Logging::logError) << "No NNUE net loaded";
+        return 1;
+    }
+    const size_t threads = DynamicConfig::threads > 1 ? DynamicConfig::threads : std::max(1u,std::thread::hardware_concurrency());
+    const size_t chunkSize = 1<<18;
+    const size_t grain = 16*NNUEEvaluator::batch_size;
+    const bool binary = input.size() > 4 && input.substr(input.size()-4) == ".bin";
+    std::ifstream is(input, binary ? std::ios::in | std::ios::binary : std::ios::in);
+    std::ofstream os(output, binary ? std::ios::out | std::ios::binary : std::ios::out);
+    if ( !is || !os ){
+        Logging::LogIt(Logging::logError) << "Cannot open " << input << " or " << output;
+        return 1;
+    }
+    Logging::LogIt(Logging::logInfo) << "Scoring " << input << " into " << output << " using " << threads << " threads";
+    std::chrono::time_point<Clock> startTime = Clock::now();
+    size_t total = 0;
+    std::atomic<size_t> errors {0};
+    // each task reads its positions, and scores them by batch
+    auto scoreRange = [&](size_t begin, size_t end, auto && read, auto && write){
+        std::vector<Position> positions(NNUEEvaluator::batch_size);
+        std::vector<bool> valid(NNUEEvaluator::batch_size);
+        ScoreType scores[NNUEEvaluator::batch_size];
+        for(size_t k = begin; k < end; k += NNUEEvaluator::batch_size){
+            const size_t m = std::min(NNUEEvaluator::batch_size, end - k);
+            for(size_t i = 0; i < m; ++i){
+                positions[i] = Position();
+                valid[i] = read(k+i, positions[i]);
+                if ( !valid[i] ){ ++errors; positions[i] = Position(startPosition); }
+            }
+            NNUEWrapper::evaluateBatch(positions.data(), m, scores);
+            for(size_t i = 0; i < m; ++i) write(k+i, valid[i], scores[i]);
+        }
+    };
+    if ( binary ){
+#ifdef WITH_DATA2BIN
+        std::vector<PackedSfenValue> data;
+        while(is){
+            data.resize(chunkSize);
+            is.read(reinterpret_cast<char*>(data.data()), chunkSize*sizeof(PackedSfenValue));
+            data.resize(size_t(is.gcount())/sizeof(PackedSfenValue));
+            if ( data.empty() ) break;
+            TaskPool::instance().parallel_for(data.size(), [&](size_t begin, size_t end){
+                scoreRange(begin, end, [&](size_t k, Position & p){ return set_from_packed_sfen(p, data[k].sfen) == 0; },
+                                       [&](size_t k, bool ok, ScoreType score){ if ( ok ) data[k].score = score; });
+            }, threads, grain);
+            os.write(reinterpret_cast<const char*>(data.data()), data.size()*sizeof(PackedSfenValue));
+            total += data.size();
+            Logging::LogIt(Logging::logInfo) << total << " positions scored";
+        }
+#else
+        Logging::LogIt(Logging::logError) << "Binary data are not supported in this build";
+        return 1;
+#endif
+    }
+    else{
+        std::vector<std::string> lines;
+        std::string line;
+        while(true){
+            lines.clear();
+            while( lines.size() < chunkSize && std::getline(is, line) ) lines.push_back(line);
+            if ( lines.empty() ) break;
+            TaskPool::instance().parallel_for(lines.size(), [&](size_t begin, size_t end){
+                scoreRange(begin, end, [&](size_t k, Position & p){ return !lines[k].empty() && readFEN(lines[k], p, true, false, false); },
+                                       [&](size_t k, bool ok, ScoreType score){ if ( ok ) setEPDScore(lines[k], score); });
+            }, threads, grain);
+            for(const auto & l : lines) os << l << "\n";
+            total += lines.size();
+            Logging::LogIt(Logging::logInfo) << total << " positions scored";
+        }
+    }
+    const int ms = std::max(1,(int)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startTime).count());
+    Logging::LogIt(Logging::logInfo) << total << " positions scored (" << errors << " not readable, left unchanged) in " << ms << "ms, " << total*1000/ms << " pos/s";
+    return 0;
+}
+#endif
+
 int cliManagement(std::string cli, int argc, char ** argv){
 
     // first we parse options that do not need extra parameters
@@ -319,6 +440,88 @@ int cliManagement(std::string cli, int argc, char ** argv){
         return 0;
     }
 
+    if ( cli == "-book_test" ){
+        struct BookTestEntry{
+            Hash key;
+            Square from, to;
+            uint16_t weight;
+        };
+        Position p1, p2;
+        readFEN(startPosition, p1, true);
+        readFEN("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", p2, true);
+        // weight totals are very different (2 and 2000), so a distribution range kept from one probe to another would be visible
+        std::vector<BookTestEntry> entries = { {Book::polyglotHash(p1), Sq_e2, Sq_e4, 1},    {Book::polyglotHash(p1), Sq_d2, Sq_d4, 1},
+                                               {Book::polyglotHash(p2), Sq_e7, Sq_e5, 1000}, {Book::polyglotHash(p2), Sq_c7, Sq_c5, 1000} };
+        std::stable_sort(entries.begin(), entries.end(), [](const BookTestEntry & a, const BookTestEntry & b){ return a.key < b.key; });
+        const std::string fileName = "book_test.bin";
+        {
+            std::ofstream str(fileName, std::ios::binary);
+            for (const auto & e : entries){
+                unsigned char buf[16] = {0};
+                for (int k = 0 ; k < 8 ; ++k) buf[k] = (unsigned char)(e.key >> (56 - 8*k));
+                const uint16_t pm = uint16_t(e.to | (e.from << 6));
+                buf[8]  = (unsigned char)(pm >> 8);       buf[9]  = (unsigned char)(pm & 0xFF);
+                buf[10] = (unsigned char)(e.weight >> 8); buf[11] = (unsigned char)(e.weight & 0xFF);
+                str.write((const char*)buf, 16);
+            }
+        }
+        DynamicConfig::bookFile = fileName;
+        Book::init();
+        const int n = 1000;
+        std::map<std::string,int> count1, count2;
+        for (int k = 0 ; k < n ; ++k){
+            ++count1[ToString(Book::probe(p1))];
+            ++count2[ToString(Book::probe(p2))];
+        }
+        DynamicConfig::bookFile = "";
+        Book::init();
+        std::remove(fileName.c_str());
+        bool ok = true;
+        for (const auto & c : { std::make_pair(&count1, std::string("e2e4")), std::make_pair(&count1, std::string("d2d4")),
+                                std::make_pair(&count2, std::string("e7e5")), std::make_pair(&count2, std::string("c7c5")) }){
+            const int found = (*c.first)[c.second];
+            Logging::LogIt(Logging::logInfo) << c.second << " played " << found << " / " << n;
+            if ( found < n/4 || found > 3*n/4 ){ // equal weights, so about n/2 each
+                Logging::LogIt(Logging::logError) << "wrong book move frequency for " << c.second << " : " << found << " / " << n;
+                ok = false;
+            }
+        }
+        return ok ? 0 : 1;
+    }
+
+    if ( cli == "-genBitbases" ){
+        std::string fileName = "bitbaseData.hpp";
+        if ( argc > 2 ) fileName = argv[2];
+        Bitbase::generate(fileName);
+        return 0;
+    }
+
+    if ( cli == "-genMaterialTable" ){
+        std::string fileName = "material.bin";
+        if ( argc > 2 ) fileName = argv[2];
+        MaterialHash::writeMaterialTable(fileName);
+        return 0;
+    }
+
+#ifdef WITH_NNUE
+    if ( cli == "-nnueHeader" ){
+        if ( argc < 4 ){
+            Logging::LogIt(Logging::logError) << "Usage : -nnueHeader input_net output_net [NNUEscaling]";
+            return 1;
+        }
+        const int scaling = argc > 4 ? atoi(argv[4]) : 0;
+        return NNUEEvaluator::add_header(argv[2],argv[3],scaling) ? 0 : 1;
+    }
+
+    if ( cli == "-nnueScore" ){
+        if ( argc < 4 ){
+            Logging::LogIt(Logging::logError) << "Usage : -nnueScore input(.epd or .bin) output";
+            return 1;
+        }
+        return nnueScore(argv[2],argv[3]);
+    }
+#endif
+
     if ( cli == "bench" ){
         Position p;
         DepthType d = 15;
@@ -511,7 +714,7 @@ int cliManagement(std::string cli, int argc, char ** argv){
         if ( argc > 3 ) d = atoi(argv[3]);
         PerftAccumulator acc;
         auto start = Clock::now();
-        perft(p,d,acc);
+        perftParallel(p,d,acc);
         auto elapsed = std::max(1, (int)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
         Logging::LogIt(Logging::logInfo) << "Perft done in " << elapsed << "ms";
         acc.Display();
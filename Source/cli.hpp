@@ -16,12 +16,15 @@
  * -perft_test_long_fischer : run a long perf test for FRC
  * -perft_test_long : run a long perf test
  * -see_test : run a SEE test (position talen from Vajolet by Marco Belli a.k.a elcabesa)
+ * -book_test : check book weighted random selection on positions with different weight totals
  * bench : used for OpenBench ( by Andrew Grant)
   * -qsearch : run a qsearch
  * -see : run a SEE
  * -attacked :
  * -cov :
  * -eval : run an evaluation
+ * -nnueHeader : write a copy of a header less NNUE net with a versioned header (and optional NNUEscaling)
+ * -nnueScore : NNUE static scoring of an EPD or binary sfen file, using all cores
  * -gen : generate available moves
  * -testmove
  * -perft : run a perft on the given position for the given depth
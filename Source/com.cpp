@@ -1,5 +1,6 @@
 #include "com.hpp"
 
+#include "book.hpp"
 #include "logging.hpp"
 #include "searcher.hpp"
 #include "transposition.hpp"
@@ -103,6 +104,19 @@ namespace COM {
     }
 
     void thinkAsync(State st, TimeType forcedMs) { // fork a future that runs a synchorous search, if needed send returned move to GUI
+        if (st == st_searching && forcedMs != INFINITETIME && !TimeMan::isUCIPondering && !TimeMan::isUCIAnalysis) { // book move is sent immediatly, no search thread is involved
+            const Move bookMove = Book::probe(COM::position);
+            if (VALIDMOVE(bookMove)) {
+                COM::move = bookMove;
+                COM::ponderMove = INVALIDMOVE;
+                if (COM::makeMove(COM::move, true, Logging::ct == Logging::CT_uci ? "bestmove" : "move", COM::ponderMove)) {
+                    COM::stm = COM::opponent(COM::stm);
+                    COM::moves.push_back(COM::move);
+                }
+                state = st_none;
+                return;
+            }
+        }
         f = std::async(std::launch::async, [st,forcedMs] {
             COM::move = COM::thinkUntilTimeUp(forcedMs);
             const PVList & pv = ThreadPool::instance().main().getData().pv; ///@todo take PV from the deepest thread not main ???
@@ -21,10 +21,12 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <random>
 #include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <type_traits>
 #include <unordered_map>
@@ -74,7 +76,7 @@ const std::string MinicVersion = "3.03";
 #endif
 
 // *** Tuning
-//#define WITH_TIMER
+#define WITH_TIMER // switched on at runtime using Timers option
 //#define WITH_SEARCH_TUNING
 //#define WITH_TEXEL_TUNING
 //#define WITH_PIECE_TUNING
@@ -86,6 +88,7 @@ const std::string MinicVersion = "3.03";
 //#define DEBUG_HASH
 //#define DEBUG_PHASH
 //#define DEBUG_MATERIAL
+//#define DEBUG_PSQ
 //#define DEBUG_APPLY
 //#define DEBUG_GENERATION 
 //#define DEBUG_GENERATION_LEGAL // not compatible with DEBUG_PSEUDO_LEGAL
@@ -152,7 +155,7 @@ const std::string MinicVersion = "3.03";
 
 #define EXTENDMORE(extension) (!extension)
 
-typedef std::chrono::system_clock Clock;
+typedef std::chrono::steady_clock Clock; // monotonic, used to measure time (log dates use system_clock)
 typedef signed char DepthType;
 typedef int32_t Move;         // invalid if < 0
 typedef int16_t MiniMove;     // invalid if < 0
@@ -352,8 +355,8 @@ namespace MoveDifficultyUtil {
     const int       emergencyFactor           = 5;
     const float     maxStealFraction          = 0.2f; // of remaining time
 
-    extern float    variability; 
-    [[nodiscard]] inline float variabilityFactor(){ return 2 / (1 + exp(1-MoveDifficultyUtil::variability));} // inside [0.5 .. 2]
+    extern std::atomic<float> variability; // read by the time watchdog thread
+    [[nodiscard]] inline float variabilityFactor(){ return 2 / (1 + exp(1-MoveDifficultyUtil::variability.load(std::memory_order_relaxed)));} // inside [0.5 .. 2]
 }
 
 inline void updatePV(PVList & pv, const Move & m, const PVList & childPV) {
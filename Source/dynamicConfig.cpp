@@ -4,6 +4,11 @@ namespace DynamicConfig{
     bool mateFinder          = false;
     bool disableTT           = false;
     unsigned int ttSizeMb    = 128; // here in Mb, will be converted to real size next
+    unsigned int ttPawnSizeMb = 4;  // pawn hash size of each thread, in Mb
+    std::string ttFile       = "";  // TT file loaded at startup (or when changed) and used by default by savett/loadtt commands
+    bool ttFileEveryGame     = false; // reload TTFile at each new game instead of keeping the table as is
+    int ttSaveMinDepth       = 0;
+    std::string ttSharedMemory = ""; // name of a POSIX shared memory segment for the TT, empty means private TT
     bool fullXboardOutput    = false;
     bool debugMode           = false;
     bool quiet               = true;
@@ -11,7 +16,9 @@ namespace DynamicConfig{
     unsigned int level       = 100;
     unsigned int randomOpen  = 0;
     unsigned int threads     = 1;
+    bool abdada              = false;
     std::string syzygyPath   = "";
+    bool syzygyPrefetch      = false;
     bool FRC                 = false;
     bool UCIPonder           = false;
     unsigned int multiPV     = 1;
@@ -22,6 +29,11 @@ namespace DynamicConfig{
     bool useNNUE             = false;
     bool forceNNUE           = false;
     std::string NNUEFile     = "";
+    std::string materialTableFile = "";
+    std::string bookFile     = "";
+    bool bookBestMove        = false;
+    bool timers              = false;
+    unsigned int timerSampling = 16;
     bool genFen              = false;
     unsigned int genFenDepth = 8;
     unsigned int randomPly   = 0;
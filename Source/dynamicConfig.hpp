@@ -11,6 +11,11 @@ namespace DynamicConfig{
     extern bool mateFinder          ;
     extern bool disableTT           ;
     extern unsigned int ttSizeMb    ;
+    extern unsigned int ttPawnSizeMb;
+    extern std::string ttFile       ;
+    extern bool ttFileEveryGame     ;
+    extern int ttSaveMinDepth       ;
+    extern std::string ttSharedMemory;
     extern bool fullXboardOutput    ;
     extern bool debugMode           ;
     extern bool quiet               ;
@@ -18,7 +23,9 @@ namespace DynamicConfig{
     extern unsigned int level       ;
     extern unsigned int randomOpen  ; 
     extern unsigned int threads     ;
+    extern bool abdada              ;
     extern std::string syzygyPath   ;
+    extern bool syzygyPrefetch      ;
     extern bool FRC                 ;
     extern bool UCIPonder           ;
     extern unsigned int multiPV     ;
@@ -29,6 +36,11 @@ namespace DynamicConfig{
     extern bool useNNUE             ;
     extern bool forceNNUE           ;
     extern std::string NNUEFile     ;
+    extern std::string materialTableFile;
+    extern std::string bookFile     ;
+    extern bool bookBestMove        ;
+    extern bool timers              ;
+    extern unsigned int timerSampling;
     extern bool genFen              ;
     extern unsigned int genFenDepth ;
     extern unsigned int randomPly   ;
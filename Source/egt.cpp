@@ -11,6 +11,157 @@ extern "C" {
 #include "tbprobe.h"
 }
 
+#include <climits>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifndef WITHOUT_FILESYSTEM
+#include <filesystem>
+#endif
+
+namespace{
+   // A lockless WDL cache in front of Fathom, shared by all search threads.
+   // Each slot packs the upper bits of the position hash with the probe result (wdl+1, 0 being an empty slot)
+   // so that a torn read is impossible and a wrong key is simply a miss.
+   const unsigned long long int wdlCacheSize = 1024*1024; // 8Mb
+   const uint64_t wdlCacheMask   = 0xFFull;
+   const uint64_t wdlCacheFailed = 0xFFull;
+   std::unique_ptr<std::atomic<uint64_t>[]> wdlCache = nullptr;
+
+   void clearWDLCache(){
+      if ( !wdlCache ) wdlCache.reset(new std::atomic<uint64_t>[wdlCacheSize]);
+      for (unsigned long long int k = 0; k < wdlCacheSize; ++k) wdlCache[k].store(0ull,std::memory_order_relaxed);
+   }
+
+   // Ask the OS to bring a file inside page cache (this memory is shared with Fathom own mappings)
+   // returns the file size if the request was done, 0 otherwise
+   unsigned long long int adviseFile(const std::string & fileName){
+#ifdef __linux__
+      unsigned long long int size = 0;
+      const int fd = ::open(fileName.c_str(), O_RDONLY);
+      if ( fd < 0 ) return 0;
+      struct stat st;
+      if ( fstat(fd,&st) == 0 && st.st_size > 0 ){
+         void * data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+         if ( data != MAP_FAILED ){
+            madvise(data, st.st_size, MADV_WILLNEED);
+            munmap(data, st.st_size);
+            size = st.st_size;
+         }
+      }
+      ::close(fd);
+      return size;
+#else
+      return 0;
+#endif
+   }
+
+   [[nodiscard]] std::vector<std::string> tbDirectories(){
+      std::vector<std::string> dirs;
+      tokenize(DynamicConfig::syzygyPath, dirs, ":");
+      return dirs;
+   }
+
+   void prefetchTBFiles(){
+#if defined(__linux__) && !defined(WITHOUT_FILESYSTEM)
+      size_t nbFiles = 0;
+      unsigned long long int totalSize = 0;
+      for (const auto & dir : tbDirectories()){
+         std::error_code ec;
+         for (const auto & f : std::filesystem::directory_iterator(dir,ec)){
+            if ( f.path().extension() != ".rtbw" ) continue;
+            const unsigned long long int size = adviseFile(f.path().string());
+            if ( size ) ++nbFiles, totalSize += size;
+         }
+      }
+      Logging::LogIt(Logging::logInfo) << "TB prefetch requested for " << nbFiles << " files (" << totalSize/1024/1024 << "Mb)";
+#else
+      Logging::LogIt(Logging::logWarn) << "TB prefetch is not available on this platform";
+#endif
+   }
+
+   // Syzygy file name part for one side, from piece count q,r,b,n,p
+   [[nodiscard]] std::string tbSideName(const std::array<int,5> & count){
+      static const char names[5] = {'Q','R','B','N','P'};
+      std::string s = "K";
+      for (int t = 0; t < 5; ++t) s += std::string(count[t],names[t]);
+      return s;
+   }
+
+   // list all materials (as Syzygy names) reachable from the given one by captures (and promotions to queen)
+   void tbReachableMaterials(std::array<std::array<int,5>,2> & cur, const std::array<std::array<int,5>,2> & max, int idx, std::set<std::string> & names){
+      if ( idx == 10 ){
+         int nbPieces = 2;
+         for (Color c = Co_White; c <= Co_Black; ++c) for (int t = 0; t < 5; ++t) nbPieces += cur[c][t];
+         if ( nbPieces > 2 && nbPieces <= SyzygyTb::MAX_TB_MEN ){
+            names.insert(tbSideName(cur[Co_White]) + "v" + tbSideName(cur[Co_Black]));
+            names.insert(tbSideName(cur[Co_Black]) + "v" + tbSideName(cur[Co_White]));
+         }
+         return;
+      }
+      const Color c = Color(idx/5);
+      const int t = idx%5;
+      for (int k = 0; k <= max[c][t]; ++k){ cur[c][t] = k; tbReachableMaterials(cur, max, idx+1, names); }
+   }
+
+   // Files given to prefetch are advised by a worker thread, so that search does not wait for the OS.
+   // The worker exits when its queue is empty, it is stopped and joined when tables are re-initialised and at exit.
+   struct Prefetcher{
+      std::mutex               mutex;
+      std::set<std::string>    requested; // each file is advised only once
+      std::vector<std::string> queue;
+      std::thread              worker;
+      bool                     running = false;
+      std::atomic<bool>        stopFlag {false};
+
+      ~Prefetcher(){ stop(); }
+
+      // returns the number of files not already requested
+      size_t push(const std::vector<std::string> & files){
+         const std::lock_guard<std::mutex> lock(mutex);
+         size_t n = 0;
+         for (const auto & f : files) if ( requested.insert(f).second ) queue.push_back(f), ++n;
+         if ( n && !running ){
+            if ( worker.joinable() ) worker.join(); // already done, see run
+            running = true;
+            worker = std::thread(&Prefetcher::run, this);
+         }
+         return n;
+      }
+
+      void run(){
+         while (true){
+            std::string f;
+            {
+               const std::lock_guard<std::mutex> lock(mutex);
+               if ( stopFlag || queue.empty() ){ running = false; return; }
+               f = queue.back();
+               queue.pop_back();
+            }
+            (void)adviseFile(f);
+         }
+      }
+
+      void stop(){
+         stopFlag = true;
+         if ( worker.joinable() ) worker.join();
+         stopFlag = false;
+         const std::lock_guard<std::mutex> lock(mutex);
+         queue.clear();
+         requested.clear();
+         running = false;
+      }
+   };
+   Prefetcher prefetcher;
+}
+
 namespace SyzygyTb {
 
 int MAX_TB_MEN = -1;
@@ -32,6 +183,7 @@ MType getMoveType(const Position &p, unsigned res){
 Move getMove(const Position &p, unsigned res) { return ToMove(TB_GET_FROM(res), TB_GET_TO(res), TB_GET_EP(res) ? T_ep : getMoveType(p,res)); } // Note: castling not possible
 
 bool initTB(){
+   prefetcher.stop(); // files may have changed
    if ( DynamicConfig::syzygyPath.empty() ){
       MAX_TB_MEN = -1;
       return false;
@@ -40,9 +192,30 @@ bool initTB(){
    if (!tb_init(DynamicConfig::syzygyPath.c_str())) return MAX_TB_MEN = 0,false;
    else     MAX_TB_MEN = TB_LARGEST;
    Logging::LogIt(Logging::logInfo) << "MAX_TB_MEN: " << MAX_TB_MEN;
+   clearWDLCache();
+   if ( DynamicConfig::syzygyPrefetch ) prefetchTBFiles();
    return true;
 }
 
+void prefetch(const Position &p){
+   if ( MAX_TB_MEN <= 0 ) return;
+   if ( countBit(p.occupancy()) > MAX_TB_MEN + 2 ) return; // not near enough
+   // current material and what it can become, promotion to queen only
+   std::array<std::array<int,5>,2> max;
+   for (Color c = Co_White; c <= Co_Black; ++c){
+      max[c] = { countBit(p.pieces_const<P_wq>(c)) + countBit(p.pieces_const<P_wp>(c)), countBit(p.pieces_const<P_wr>(c)), countBit(p.pieces_const<P_wb>(c)), countBit(p.pieces_const<P_wn>(c)), countBit(p.pieces_const<P_wp>(c)) };
+   }
+   std::array<std::array<int,5>,2> cur = max;
+   std::set<std::string> names;
+   tbReachableMaterials(cur, max, 0, names);
+   std::vector<std::string> files;
+   for (const auto & dir : tbDirectories()){
+      for (const auto & n : names) files.push_back(dir + "/" + n + ".rtbw");
+   }
+   const size_t n = prefetcher.push(files);
+   if ( n ) Logging::LogIt(Logging::logInfo) << "TB prefetch of " << n << " candidate files";
+}
+
 int probe_root(Searcher & context, const Position &p, ScoreType &score, MoveList &rootMoves){
    if ( MAX_TB_MEN <= 0 ) return -1;
    score = 0;
@@ -55,8 +228,20 @@ int probe_root(Searcher & context, const Position &p, ScoreType &score, MoveList
    score = valueMap[wdl];
    if (context.isRep(p,false)) rootMoves.push_back(getMove(p,result));
    else {
+      // keep only moves preserving the best WDL, and among them, DTZ optimal ones :
+      // the fastest way to zeroing the fifty move counter when winning, the slowest when losing
       unsigned res;
-      for (int i = 0; (res = results[i]) != TB_RESULT_FAILED; i++) { if (TB_GET_WDL(res) >= wdl) rootMoves.push_back(getMove(p,res)); }
+      unsigned bestDTZ = wdl > TB_DRAW ? UINT_MAX : 0;
+      for (int i = 0; (res = results[i]) != TB_RESULT_FAILED; i++) {
+         if (TB_GET_WDL(res) < wdl) continue;
+         if      (wdl > TB_DRAW) bestDTZ = std::min(bestDTZ, (unsigned)TB_GET_DTZ(res));
+         else if (wdl < TB_DRAW) bestDTZ = std::max(bestDTZ, (unsigned)TB_GET_DTZ(res));
+      }
+      for (int i = 0; (res = results[i]) != TB_RESULT_FAILED; i++) { 
+         if (TB_GET_WDL(res) < wdl) continue;
+         if (wdl != TB_DRAW && TB_GET_DTZ(res) != bestDTZ) continue;
+         rootMoves.push_back(getMove(p,res));
+      }
    }
    return TB_GET_DTZ(result);
 }
@@ -65,9 +250,17 @@ int probe_wdl(const Position &p, ScoreType &score, bool use50MoveRule){
    if ( MAX_TB_MEN <= 0 ) return -1;
    score = 0;
    debug_king_cap(p);
-   unsigned result = tb_probe_wdl(p.allPieces[Co_White],p.allPieces[Co_Black],p.whiteKing()|p.blackKing(),p.whiteQueen()|p.blackQueen(),p.whiteRook()|p.blackRook(),p.whiteBishop()|p.blackBishop(),p.whiteKnight()|p.blackKnight(),p.whitePawn()|p.blackPawn(),p.fifty,p.castling != C_none,p.ep == INVALIDSQUARE ? 0 : p.ep,p.c == Co_White);
-   if (result == TB_RESULT_FAILED) return 0;
-   unsigned wdl = TB_GET_WDL(result);
+   // Fathom WDL result only depends on the hashed position state when fifty counter is 0 (otherwise it fails immediatly)
+   const bool cachable = wdlCache && p.fifty == 0;
+   const Hash h = cachable ? computeHash(p) : nullHash;
+   uint64_t slot = cachable ? wdlCache[h&(wdlCacheSize-1)].load(std::memory_order_relaxed) : 0ull;
+   if ( slot == 0ull || (slot & ~wdlCacheMask) != (h & ~wdlCacheMask) ){
+      const unsigned result = tb_probe_wdl(p.allPieces[Co_White],p.allPieces[Co_Black],p.whiteKing()|p.blackKing(),p.whiteQueen()|p.blackQueen(),p.whiteRook()|p.blackRook(),p.whiteBishop()|p.blackBishop(),p.whiteKnight()|p.blackKnight(),p.whitePawn()|p.blackPawn(),p.fifty,p.castling != C_none,p.ep == INVALIDSQUARE ? 0 : p.ep,p.c == Co_White);
+      slot = (h & ~wdlCacheMask) | (result == TB_RESULT_FAILED ? wdlCacheFailed : uint64_t(TB_GET_WDL(result) + 1));
+      if ( cachable ) wdlCache[h&(wdlCacheSize-1)].store(slot,std::memory_order_relaxed);
+   }
+   if ((slot & wdlCacheMask) == wdlCacheFailed) return 0;
+   const unsigned wdl = unsigned(slot & wdlCacheMask) - 1;
    assert(wdl<5);
    if (use50MoveRule) score = valueMap[wdl];
    else               score = valueMapNo50[wdl];
@@ -12,6 +12,7 @@ struct Searcher;
  * and is more or less a simple copy/paste from Arasan by Jon Dart
  * Fathom implementation (from https://github.com/jdart1/Fathom) must be cloned into "Fathom" directory
  * inside Minic root directory for this to compile/work.
+ * WDL probes are cached (lockless, shared by all threads) in front of Fathom.
  */
 namespace SyzygyTb {
 
@@ -21,8 +22,12 @@ extern int MAX_TB_MEN;
 
 bool initTB();
 
+// fill rootMoves with WDL and DTZ optimal moves, returns -1 on failure
 [[nodiscard]] int probe_root(Searcher & context, const Position &p, ScoreType &score, MoveList &rootMoves);
 
+// asynchronous prefetch of TB files that may be probed soon (only if material is near MAX_TB_MEN)
+void prefetch(const Position &p);
+
 [[nodiscard]] int probe_wdl(const Position &p, ScoreType &score, bool use50MoveRule);
 
 } // SyzygyTb
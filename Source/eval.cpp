@@ -18,9 +18,7 @@ template < Piece T , Color C, bool withForwardness = false>
 inline void evalPiece(const Position & p, BitBoard pieceBBiterator, const BitBoard (& kingZone)[2], const BitBoard nonPawnMat, const BitBoard occupancy, EvalScore & score, BitBoard & attBy, BitBoard & att, BitBoard & att2, ScoreType (& kdanger)[2], BitBoard & checkers){
     while (pieceBBiterator) {
         const Square k = popBit(pieceBBiterator);
-        const Square kk = ColorSquarePstHelper<C>(k);
-        score += EvalConfig::PST[T-1][kk] * ColorSignHelper<C>();
-        if (withForwardness) score += EvalScore{ScoreType(((DynamicConfig::styleForwardness-50)*SQRANK(kk))/8),0} * ColorSignHelper<C>();
+        if (withForwardness) score += EvalScore{ScoreType(((DynamicConfig::styleForwardness-50)*SQRANK(ColorSquarePstHelper<C>(k)))/8),0} * ColorSignHelper<C>();
         const BitBoard shadowTarget = BBTools::pfCoverage[T-1](k, occupancy ^ nonPawnMat, C); // aligned threats removing own piece (not pawn) in occupancy
         if ( shadowTarget ){
            kdanger[~C] += countBit(shadowTarget & kingZone[~C]) * EvalConfig::kingAttWeight[EvalConfig::katt_attack][T-1];
@@ -79,14 +77,6 @@ inline void evalPawnPasser(const Position & p, BitBoard pieceBBiterator, EvalSco
     }
 }
 
-template < Color C>
-inline void evalPawn(BitBoard pieceBBiterator, EvalScore & score){
-    while (pieceBBiterator) { 
-        const Square kk = ColorSquarePstHelper<C>(popBit(pieceBBiterator));
-        score += EvalConfig::PST[0][kk] * ColorSignHelper<C>(); 
-    }
-}
-
 template< Color C>
 inline void evalPawnFreePasser(const Position & p, BitBoard pieceBBiterator, EvalScore & score){
     while (pieceBBiterator) {
@@ -105,23 +95,38 @@ inline void evalPawnCandidate(BitBoard pieceBBiterator, EvalScore & score){
     while (pieceBBiterator) { score += EvalConfig::candidate[ColorRank<C>(popBit(pieceBBiterator))] * ColorSignHelper<C>();}
 }
 
-template< Color C>
-BitBoard getPinned(const Position & p, const Square s){
-    BitBoard pinned = emptyBitBoard;
-    if ( s == INVALIDSQUARE ) return pinned;
-    BitBoard pinner = BBTools::attack<P_wb>(s, p.pieces_const<P_wb>(~C) | p.pieces_const<P_wq>(~C), p.allPieces[~C]) 
-                    | BBTools::attack<P_wr>(s, p.pieces_const<P_wr>(~C) | p.pieces_const<P_wq>(~C), p.allPieces[~C]);
-    while ( pinner ) { pinned |= BBTools::mask[popBit(pinner)].between[p.king[C]] & p.allPieces[C]; }
-    return pinned;
-}
-
 bool isLazyHigh(ScoreType lazyThreshold, const EvalFeatures & features, EvalScore & score) {
     score = features.SumUp();
     return std::abs(score[MG] + score[EG]) / 2 > lazyThreshold;
 }
 
-ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safeMatEvaluator, bool display, std::ostream * of){
-    START_TIMER
+// tiered evaluation : is the partial score (side to move point of view) outside the caller window, with a margin for missing terms ?
+bool isLazyOutside(ScoreType lazyAlpha, ScoreType lazyBeta, ScoreType margin, const Position & p, const EvalData & data, const EvalFeatures & features, const Searcher &context, ScoreType & partial) {
+    const EvalScore score = features.SumUp();
+    partial = (p.c == Co_White?+1:-1)*Score(ScaleScore(score+context.contempt,data.gp),features.scalingFactor,p);
+    return partial - margin >= lazyBeta || partial + margin <= lazyAlpha;
+}
+
+// lazy exit at given tier, saving what was summed so far if the caller wants to complete this evaluation later
+inline ScoreType lazyExit(unsigned char tier, ScoreType partialScore, EvalData & data, const EvalFeatures & features, EvalPartial * partial){
+    if ( partial ){
+        partial->features = features;
+        partial->tier = tier;
+    }
+    data.lazy = true;
+    return partialScore;
+}
+
+ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safeMatEvaluator, bool display, std::ostream * of, ScoreType lazyAlpha, ScoreType lazyBeta, EvalPartial * partial){
+    START_TIMER(Eval)
+
+    // display and features output always need the full evaluation
+    if ( display || of ){ lazyAlpha = -MATE; lazyBeta = MATE; }
+    // tier reached by a previous lazy call (material, game phase and PST are then already known)
+    const unsigned char resumeTier = partial ? partial->tier : 0;
+    if ( partial ) partial->tier = 0;
+
+    data.lazy = false;
 
     // king captured
     const bool white2Play = p.c == Co_White;
@@ -141,74 +146,105 @@ ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safe
     // main features
     EvalFeatures features;
 
-    // Material evaluation
-    const Hash matHash = MaterialHash::getMaterialHash(p.mat);
-    if ( matHash != nullHash ){
-       ++context.stats.counters[Stats::sid_materialTableHits];
-       // Hash data
-       const MaterialHash::MaterialHashEntry & MEntry = MaterialHash::materialHashTable[matHash];
-       data.gp = MEntry.gp;
-       features.scores[F_material] += MEntry.score;
-       // end game knowledge (helper or scaling)
-       if ( safeMatEvaluator && (p.mat[Co_White][M_t]+p.mat[Co_Black][M_t]<6) ){
-          const Color winningSideEG = features.scores[F_material][EG]>0?Co_White:Co_Black;
-          if ( MEntry.t == MaterialHash::Ter_WhiteWinWithHelper || MEntry.t == MaterialHash::Ter_BlackWinWithHelper ){
-            STOP_AND_SUM_TIMER(Eval)
-            ++context.stats.counters[Stats::sid_materialTableHelper];
-            return (white2Play?+1:-1)*(MaterialHash::helperTable[matHash](p,winningSideEG,features.scores[F_material][EG]));
-          }
-          else if ( MEntry.t == MaterialHash::Ter_Draw){ 
-              if (!isAttacked(p, kingSquare(p))) {
-                 STOP_AND_SUM_TIMER(Eval)
-                 ++context.stats.counters[Stats::sid_materialTableDraw];
-                 return context.drawScore();
-              }
-          }
-          else if ( MEntry.t == MaterialHash::Ter_MaterialDraw) {
-              if (!isAttacked(p, kingSquare(p))){
+    if ( resumeTier ) features = partial->features;
+    else {
+       // Material evaluation
+       const Hash matHash = MaterialHash::getMaterialHash(p.mat);
+       if ( matHash != nullHash ){
+          ++context.stats.counters[Stats::sid_materialTableHits];
+          // Hash data
+          const MaterialHash::MaterialHashEntry & MEntry = MaterialHash::materialHashTable[matHash];
+          data.gp = MEntry.gp();
+          features.scores[F_material] += MEntry.score;
+          // end game knowledge (helper or scaling)
+          if ( safeMatEvaluator && (p.mat[Co_White][M_t]+p.mat[Co_Black][M_t]<6) ){
+             const Color winningSideEG = features.scores[F_material][EG]>0?Co_White:Co_Black;
+             if ( MEntry.t == MaterialHash::Ter_WhiteWinWithHelper || MEntry.t == MaterialHash::Ter_BlackWinWithHelper ){
+               const ScoreType helperScore = MaterialHash::helperTable[matHash](p,winningSideEG,features.scores[F_material][EG]);
+               if ( helperScore != MaterialHash::helperUnknown ){ // otherwise, go on with standard evaluation
                   STOP_AND_SUM_TIMER(Eval)
-                  ++context.stats.counters[Stats::sid_materialTableDraw2];
-                  return context.drawScore();
-              }
+                  ++context.stats.counters[Stats::sid_materialTableHelper];
+                  return (white2Play?+1:-1)*helperScore;
+               }
+             }
+             else if ( MEntry.t == MaterialHash::Ter_Draw){ 
+                 if (!isAttacked(p, kingSquare(p))) {
+                    STOP_AND_SUM_TIMER(Eval)
+                    ++context.stats.counters[Stats::sid_materialTableDraw];
+                    return context.drawScore();
+                 }
+             }
+             else if ( MEntry.t == MaterialHash::Ter_MaterialDraw) {
+                 if (!isAttacked(p, kingSquare(p))){
+                     STOP_AND_SUM_TIMER(Eval)
+                     ++context.stats.counters[Stats::sid_materialTableDraw2];
+                     return context.drawScore();
+                 }
+             }
+             else if ( MEntry.t == MaterialHash::Ter_WhiteWin || MEntry.t == MaterialHash::Ter_BlackWin) features.scalingFactor = 5 - 5*p.fifty/100.f;
+             else if ( MEntry.t == MaterialHash::Ter_HardToWin)  features.scalingFactor = 0.5f - 0.5f*(p.fifty/100.f);
+             else if ( MEntry.t == MaterialHash::Ter_LikelyDraw) features.scalingFactor = 0.3f - 0.3f*(p.fifty/100.f);
           }
-          else if ( MEntry.t == MaterialHash::Ter_WhiteWin || MEntry.t == MaterialHash::Ter_BlackWin) features.scalingFactor = 5 - 5*p.fifty/100.f;
-          else if ( MEntry.t == MaterialHash::Ter_HardToWin)  features.scalingFactor = 0.5f - 0.5f*(p.fifty/100.f);
-          else if ( MEntry.t == MaterialHash::Ter_LikelyDraw) features.scalingFactor = 0.3f - 0.3f*(p.fifty/100.f);
        }
-    }
-    else{ // game phase and material scores out of table
-       ///@todo don't care about imbalance here ?
-       ScoreType matScoreW = 0;
-       ScoreType matScoreB = 0;
-       data.gp = gamePhase(p,matScoreW, matScoreB);
-       features.scores[F_material] += EvalScore((p.mat[Co_White][M_q] - p.mat[Co_Black][M_q]) * *absValuesEG[P_wq] + (p.mat[Co_White][M_r] - p.mat[Co_Black][M_r]) * *absValuesEG[P_wr] + (p.mat[Co_White][M_b] - p.mat[Co_Black][M_b]) * *absValuesEG[P_wb] + (p.mat[Co_White][M_n] - p.mat[Co_Black][M_n]) * *absValuesEG[P_wn] + (p.mat[Co_White][M_p] - p.mat[Co_Black][M_p]) * *absValuesEG[P_wp], matScoreW - matScoreB);
-       ++context.stats.counters[Stats::sid_materialTableMiss];
-    }
+       else{ // game phase and material scores out of table
+          ///@todo don't care about imbalance here ?
+          ScoreType matScoreW = 0;
+          ScoreType matScoreB = 0;
+          data.gp = gamePhase(p,matScoreW, matScoreB);
+          features.scores[F_material] += EvalScore((p.mat[Co_White][M_q] - p.mat[Co_Black][M_q]) * *absValuesEG[P_wq] + (p.mat[Co_White][M_r] - p.mat[Co_Black][M_r]) * *absValuesEG[P_wr] + (p.mat[Co_White][M_b] - p.mat[Co_Black][M_b]) * *absValuesEG[P_wb] + (p.mat[Co_White][M_n] - p.mat[Co_Black][M_n]) * *absValuesEG[P_wn] + (p.mat[Co_White][M_p] - p.mat[Co_Black][M_p]) * *absValuesEG[P_wp], matScoreW - matScoreB);
+          ++context.stats.counters[Stats::sid_materialTableMiss];
+       }
 
-#ifdef WITH_TEXEL_TUNING
-    features.scores[F_material] += MaterialHash::Imbalance(p.mat, Co_White) - MaterialHash::Imbalance(p.mat, Co_Black);
-#endif
+   #ifdef WITH_TEXEL_TUNING
+       features.scores[F_material] += MaterialHash::Imbalance(p.mat, Co_White) - MaterialHash::Imbalance(p.mat, Co_Black);
+   #endif
+
+   #ifdef WITH_NNUE
+       if (DynamicConfig::useNNUE){
+           EvalScore score;
+           if ( DynamicConfig::forceNNUE || ! isLazyHigh(600,features,score)){ // stay to classic eval when the game is already decided
+              ScoreType nnueScore = p.Evaluator().propagate(p.c);
+              // NNUE evaluation scaling
+              nnueScore = (Score(nnueScore,features.scalingFactor,p) * NNUEWrapper::NNUEscaling) / 64;
+              // take tempo and contempt into account
+              nnueScore += ScaleScore( /*EvalConfig::tempo*(white2Play?+1:-1) +*/ context.contempt, data.gp);
+              ++context.stats.counters[Stats::sid_evalNNUE];
+              STOP_AND_SUM_TIMER(Eval)
+              return nnueScore;
+           }
+           ++context.stats.counters[Stats::sid_evalStd];
+       }
+   #endif
+
+       // PST (incrementally updated inside Position)
+   #ifdef WITH_TEXEL_TUNING
+       features.scores[F_positional] += computePSQ(p); // PST are being tuned, Position::psq may be outdated
+   #else
+       features.scores[F_positional] += p.psq;
+   #endif
+
+       // lazy eval, material and PST only, before all expensive terms
+       if ( !display && !of ){
+           EvalScore score = 0;
+           if ( isLazyHigh(1000,features,score)){
+               ++context.stats.counters[Stats::sid_evalLazy];
+               STOP_AND_SUM_TIMER(Eval)
+               return (white2Play?+1:-1)*Score(ScaleScore(score+context.contempt,data.gp),features.scalingFactor,p);
+           }
+           // first tier, material and PST only
+           ScoreType partialScore = 0;
+           if ( isLazyOutside(lazyAlpha,lazyBeta,SearchConfig::lazyEvalMargin[0],p,data,features,context,partialScore) ){
+               ++context.stats.counters[Stats::sid_evalTier1];
+               STOP_AND_SUM_TIMER(Eval)
+               return lazyExit(1,partialScore,data,features,partial);
+           }
+       }
 
-#ifdef WITH_NNUE
-    if (DynamicConfig::useNNUE){
-        EvalScore score;
-        if ( DynamicConfig::forceNNUE || ! isLazyHigh(600,features,score)){ // stay to classic eval when the game is already decided
-           ScoreType nnueScore = p.Evaluator().propagate(p.c);
-           // NNUE evaluation scaling
-           nnueScore = (Score(nnueScore,features.scalingFactor,p) * NNUEWrapper::NNUEscaling) / 64;
-           // take tempo and contempt into account
-           nnueScore += ScaleScore( /*EvalConfig::tempo*(white2Play?+1:-1) +*/ context.contempt, data.gp);
-           ++context.stats.counters[Stats::sid_evalNNUE];
-           STOP_AND_SUM_TIMER(Eval)
-           return nnueScore;
-        }
-        ++context.stats.counters[Stats::sid_evalStd];
     }
-#endif
 
     STOP_AND_SUM_TIMER(Eval1)
 
-    context.prefetchPawn(computeHash(p));
+    context.prefetchPawn(computePHash(p));
 
     // usefull bitboards 
     const BitBoard pawns[2]   = {p.whitePawn()  , p.blackPawn()};
@@ -220,6 +256,9 @@ ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safe
     const BitBoard nonPawnMat[2] = {p.allPieces[Co_White] & ~pawns[Co_White] , p.allPieces[Co_Black] & ~pawns[Co_Black]};
     const BitBoard kingZone[2]   = { BBTools::mask[p.king[Co_White]].kingZone, BBTools::mask[p.king[Co_Black]].kingZone};
     const BitBoard occupancy     = p.occupancy();
+    // cheap enough to be recomputed, so that a pawn hash entry fits in a cache line
+    const BitBoard pawnTargets[2] = {BBTools::pawnAttacks<Co_White>(pawns[Co_White]), BBTools::pawnAttacks<Co_Black>(pawns[Co_Black])};
+    const BitBoard openFiles      = BBTools::openFiles(pawns[Co_White], pawns[Co_Black]);
 
     ScoreType kdanger[2]        = {0, 0};
     BitBoard att[2]             = {emptyBitBoard, emptyBitBoard}; // bitboard of squares attacked by Color
@@ -227,37 +266,6 @@ ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safe
     BitBoard attFromPiece[2][6] = {{emptyBitBoard}};      // bitboard of squares attacked by specific piece of Color
     BitBoard checkers[2][6]     = {{emptyBitBoard}};      // bitboard of Color pieces squares attacking king
 
-    // PST, attack, danger
-    if ( DynamicConfig::styleForwardness != 50 ){
-       evalPiece<P_wn,Co_White,true>(p,knights[Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wn-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wn-1]);
-       evalPiece<P_wb,Co_White,true>(p,bishops[Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wb-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wb-1]);
-       evalPiece<P_wr,Co_White,true>(p,rooks  [Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wr-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wr-1]);
-       evalPiece<P_wq,Co_White,true>(p,queens [Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wq-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wq-1]);
-       evalPiece<P_wk,Co_White,true>(p,kings  [Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wk-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wk-1]);
-       evalPiece<P_wn,Co_Black,true>(p,knights[Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wn-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wn-1]);
-       evalPiece<P_wb,Co_Black,true>(p,bishops[Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wb-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wb-1]);
-       evalPiece<P_wr,Co_Black,true>(p,rooks  [Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wr-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wr-1]);
-       evalPiece<P_wq,Co_Black,true>(p,queens [Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wq-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wq-1]);
-       evalPiece<P_wk,Co_Black,true>(p,kings  [Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wk-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wk-1]);
-    }
-    else{
-       evalPiece<P_wn,Co_White>(p,knights[Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wn-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wn-1]);
-       evalPiece<P_wb,Co_White>(p,bishops[Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wb-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wb-1]);
-       evalPiece<P_wr,Co_White>(p,rooks  [Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wr-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wr-1]);
-       evalPiece<P_wq,Co_White>(p,queens [Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wq-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wq-1]);
-       evalPiece<P_wk,Co_White>(p,kings  [Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wk-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wk-1]);
-       evalPiece<P_wn,Co_Black>(p,knights[Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wn-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wn-1]);
-       evalPiece<P_wb,Co_Black>(p,bishops[Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wb-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wb-1]);
-       evalPiece<P_wr,Co_Black>(p,rooks  [Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wr-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wr-1]);
-       evalPiece<P_wq,Co_Black>(p,queens [Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wq-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wq-1]);
-       evalPiece<P_wk,Co_Black>(p,kings  [Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wk-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wk-1]);
-    }
-
-    // random factor in opening if requiered
-    if ( p.halfmoves < 10 && DynamicConfig::randomOpen != 0 ) features.scores[F_positional] += randomInt<ScoreType /*NO SEED => random device*/>(-DynamicConfig::randomOpen,DynamicConfig::randomOpen);
-
-    STOP_AND_SUM_TIMER(Eval2)
-
     Searcher::PawnEntry * pePtr = nullptr;
 #ifdef WITH_TEXEL_TUNING
     Searcher::PawnEntry dummy; // used for texel tuning
@@ -269,32 +277,25 @@ ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safe
        assert(pePtr);
        Searcher::PawnEntry & pe = *pePtr;
        pe.reset();
-       pe.pawnTargets   [Co_White] = BBTools::pawnAttacks   <Co_White>(pawns[Co_White]); 
-       pe.pawnTargets   [Co_Black] = BBTools::pawnAttacks   <Co_Black>(pawns[Co_Black]);
        pe.semiOpenFiles [Co_White] = BBTools::fillFile(pawns[Co_White]) & ~BBTools::fillFile(pawns[Co_Black]); // semiOpen white means with white pawn, and without black pawn
        pe.semiOpenFiles [Co_Black] = BBTools::fillFile(pawns[Co_Black]) & ~BBTools::fillFile(pawns[Co_White]); 
        pe.passed        [Co_White] = BBTools::pawnPassed    <Co_White>(pawns[Co_White],pawns[Co_Black]); 
        pe.passed        [Co_Black] = BBTools::pawnPassed    <Co_Black>(pawns[Co_Black],pawns[Co_White]);
        pe.holes         [Co_White] = BBTools::pawnHoles     <Co_White>(pawns[Co_White]) & holesZone[Co_White]; 
        pe.holes         [Co_Black] = BBTools::pawnHoles     <Co_Black>(pawns[Co_Black]) & holesZone[Co_White];
-       pe.openFiles =  BBTools::openFiles(pawns[Co_White], pawns[Co_Black]);
 
-       // PST, attack
-       evalPawn<Co_White>(pawns[Co_White],pe.score);
-       evalPawn<Co_Black>(pawns[Co_Black],pe.score);
-       
        // danger in king zone
-       pe.danger[Co_White] -= countBit(pe.pawnTargets[Co_White] & kingZone[Co_White]) * EvalConfig::kingAttWeight[EvalConfig::katt_defence][0]; // 0 means pawn here
-       pe.danger[Co_White] += countBit(pe.pawnTargets[Co_Black] & kingZone[Co_White]) * EvalConfig::kingAttWeight[EvalConfig::katt_attack] [0];
-       pe.danger[Co_Black] -= countBit(pe.pawnTargets[Co_Black] & kingZone[Co_Black]) * EvalConfig::kingAttWeight[EvalConfig::katt_defence][0];
-       pe.danger[Co_Black] += countBit(pe.pawnTargets[Co_White] & kingZone[Co_Black]) * EvalConfig::kingAttWeight[EvalConfig::katt_attack] [0];
+       pe.danger[Co_White] -= countBit(pawnTargets[Co_White] & kingZone[Co_White]) * EvalConfig::kingAttWeight[EvalConfig::katt_defence][0]; // 0 means pawn here
+       pe.danger[Co_White] += countBit(pawnTargets[Co_Black] & kingZone[Co_White]) * EvalConfig::kingAttWeight[EvalConfig::katt_attack] [0];
+       pe.danger[Co_Black] -= countBit(pawnTargets[Co_Black] & kingZone[Co_Black]) * EvalConfig::kingAttWeight[EvalConfig::katt_defence][0];
+       pe.danger[Co_Black] += countBit(pawnTargets[Co_White] & kingZone[Co_Black]) * EvalConfig::kingAttWeight[EvalConfig::katt_attack] [0];
        
        // pawn passer
        evalPawnPasser<Co_White>(p,pe.passed[Co_White],pe.score);
        evalPawnPasser<Co_Black>(p,pe.passed[Co_Black],pe.score);
        // pawn protected
-       evalPawnProtected<Co_White>(pe.passed[Co_White] & pe.pawnTargets[Co_White],pe.score);
-       evalPawnProtected<Co_Black>(pe.passed[Co_Black] & pe.pawnTargets[Co_Black],pe.score);
+       evalPawnProtected<Co_White>(pe.passed[Co_White] & pawnTargets[Co_White],pe.score);
+       evalPawnProtected<Co_Black>(pe.passed[Co_Black] & pawnTargets[Co_Black],pe.score);
        // pawn candidate
        const BitBoard candidates    [2] = {BBTools::pawnCandidates<Co_White>(pawns[Co_White],pawns[Co_Black]) , BBTools::pawnCandidates<Co_Black>(pawns[Co_Black],pawns[Co_White])};
        evalPawnCandidate<Co_White>(candidates[Co_White],pe.score);
@@ -372,10 +373,10 @@ ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safe
        pe.score -= EvalConfig::pawnStormMalus * countBit(kingFlank[wkf] & (rank3|rank4) & pawns[Co_Black]);
        pe.score += EvalConfig::pawnStormMalus * countBit(kingFlank[bkf] & (rank5|rank6) & pawns[Co_White]);
        // open file near king
-       pe.danger[Co_White] += EvalConfig::kingAttOpenfile        * countBit(kingFlank[wkf] & pe.openFiles              )/8;
+       pe.danger[Co_White] += EvalConfig::kingAttOpenfile        * countBit(kingFlank[wkf] & openFiles              )/8;
        pe.danger[Co_White] += EvalConfig::kingAttSemiOpenfileOpp * countBit(kingFlank[wkf] & pe.semiOpenFiles[Co_White])/8;
        pe.danger[Co_White] += EvalConfig::kingAttSemiOpenfileOur * countBit(kingFlank[wkf] & pe.semiOpenFiles[Co_Black])/8;
-       pe.danger[Co_Black] += EvalConfig::kingAttOpenfile        * countBit(kingFlank[bkf] & pe.openFiles              )/8;
+       pe.danger[Co_Black] += EvalConfig::kingAttOpenfile        * countBit(kingFlank[bkf] & openFiles              )/8;
        pe.danger[Co_Black] += EvalConfig::kingAttSemiOpenfileOpp * countBit(kingFlank[bkf] & pe.semiOpenFiles[Co_Black])/8;
        pe.danger[Co_Black] += EvalConfig::kingAttSemiOpenfileOur * countBit(kingFlank[bkf] & pe.semiOpenFiles[Co_White])/8;
        // Fawn
@@ -389,7 +390,48 @@ ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safe
     }
     assert(pePtr);
     const Searcher::PawnEntry & pe = *pePtr;
-    features.scores[F_pawnStruct] += pe.score;
+    if ( resumeTier < 2 ) features.scores[F_pawnStruct] += pe.score;
+
+    // second tier, with pawn structure (often from pawn hash) but before mobility, king safety, threats, ...
+    if ( !display && !of ){
+        ScoreType partialScore = 0;
+        if ( isLazyOutside(lazyAlpha,lazyBeta,SearchConfig::lazyEvalMargin[1],p,data,features,context,partialScore) ){
+            ++context.stats.counters[Stats::sid_evalTier2];
+            STOP_AND_SUM_TIMER(Eval)
+            return lazyExit(2,partialScore,data,features,partial);
+        }
+    }
+
+    // attack, danger
+    if ( DynamicConfig::styleForwardness != 50 ){
+       evalPiece<P_wn,Co_White,true>(p,knights[Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wn-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wn-1]);
+       evalPiece<P_wb,Co_White,true>(p,bishops[Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wb-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wb-1]);
+       evalPiece<P_wr,Co_White,true>(p,rooks  [Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wr-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wr-1]);
+       evalPiece<P_wq,Co_White,true>(p,queens [Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wq-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wq-1]);
+       evalPiece<P_wk,Co_White,true>(p,kings  [Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wk-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wk-1]);
+       evalPiece<P_wn,Co_Black,true>(p,knights[Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wn-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wn-1]);
+       evalPiece<P_wb,Co_Black,true>(p,bishops[Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wb-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wb-1]);
+       evalPiece<P_wr,Co_Black,true>(p,rooks  [Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wr-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wr-1]);
+       evalPiece<P_wq,Co_Black,true>(p,queens [Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wq-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wq-1]);
+       evalPiece<P_wk,Co_Black,true>(p,kings  [Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wk-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wk-1]);
+    }
+    else{
+       evalPiece<P_wn,Co_White>(p,knights[Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wn-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wn-1]);
+       evalPiece<P_wb,Co_White>(p,bishops[Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wb-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wb-1]);
+       evalPiece<P_wr,Co_White>(p,rooks  [Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wr-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wr-1]);
+       evalPiece<P_wq,Co_White>(p,queens [Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wq-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wq-1]);
+       evalPiece<P_wk,Co_White>(p,kings  [Co_White],kingZone,nonPawnMat[Co_White],occupancy,features.scores[F_positional],attFromPiece[Co_White][P_wk-1],att[Co_White],att2[Co_White],kdanger,checkers[Co_White][P_wk-1]);
+       evalPiece<P_wn,Co_Black>(p,knights[Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wn-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wn-1]);
+       evalPiece<P_wb,Co_Black>(p,bishops[Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wb-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wb-1]);
+       evalPiece<P_wr,Co_Black>(p,rooks  [Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wr-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wr-1]);
+       evalPiece<P_wq,Co_Black>(p,queens [Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wq-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wq-1]);
+       evalPiece<P_wk,Co_Black>(p,kings  [Co_Black],kingZone,nonPawnMat[Co_Black],occupancy,features.scores[F_positional],attFromPiece[Co_Black][P_wk-1],att[Co_Black],att2[Co_Black],kdanger,checkers[Co_Black][P_wk-1]);
+    }
+
+    // random factor in opening if requiered
+    if ( p.halfmoves < 10 && DynamicConfig::randomOpen != 0 ) features.scores[F_positional] += randomInt<ScoreType /*NO SEED => random device*/>(-DynamicConfig::randomOpen,DynamicConfig::randomOpen);
+
+    STOP_AND_SUM_TIMER(Eval2)
 
 /*
     // lazy eval
@@ -407,10 +449,10 @@ ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safe
     kdanger[Co_Black] += pe.danger[Co_Black];
     checkers[Co_White][0] = BBTools::pawnAttacks<Co_Black>(kings[Co_Black]) & pawns[Co_White];
     checkers[Co_Black][0] = BBTools::pawnAttacks<Co_White>(kings[Co_White]) & pawns[Co_Black];
-    att2[Co_White] |= att[Co_White] & pe.pawnTargets[Co_White];
-    att2[Co_Black] |= att[Co_Black] & pe.pawnTargets[Co_Black];
-    att[Co_White]  |= pe.pawnTargets[Co_White];
-    att[Co_Black]  |= pe.pawnTargets[Co_Black];
+    att2[Co_White] |= att[Co_White] & pawnTargets[Co_White];
+    att2[Co_Black] |= att[Co_Black] & pawnTargets[Co_Black];
+    att[Co_White]  |= pawnTargets[Co_White];
+    att[Co_Black]  |= pawnTargets[Co_Black];
 
     STOP_AND_SUM_TIMER(Eval3)
 
@@ -420,7 +462,7 @@ ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safe
 
     const BitBoard weakSquare[2]       = {att[Co_Black] & ~att2[Co_White] & (~att[Co_White] | attFromPiece[Co_White][P_wk-1] | attFromPiece[Co_White][P_wq-1]) , att[Co_White] & ~att2[Co_Black] & (~att[Co_Black] | attFromPiece[Co_Black][P_wk-1] | attFromPiece[Co_Black][P_wq-1])};
     const BitBoard safeSquare[2]       = {~att[Co_Black] | ( weakSquare[Co_Black] & att2[Co_White] ) , ~att[Co_White] | ( weakSquare[Co_White] & att2[Co_Black] ) };
-    const BitBoard protectedSquare[2]  = {pe.pawnTargets[Co_White] | attackedAndNotDefended[Co_White] | attacked2AndNotDefended2[Co_White] , pe.pawnTargets[Co_Black] | attackedAndNotDefended[Co_Black] | attacked2AndNotDefended2[Co_Black] };
+    const BitBoard protectedSquare[2]  = {pawnTargets[Co_White] | attackedAndNotDefended[Co_White] | attacked2AndNotDefended2[Co_White] , pawnTargets[Co_Black] | attackedAndNotDefended[Co_Black] | attacked2AndNotDefended2[Co_Black] };
 
     // own piece in front of pawn
     features.scores[F_development] += EvalConfig::pieceFrontPawn * countBit( BBTools::shiftN<Co_White>(pawns[Co_White]) & nonPawnMat[Co_White] );
@@ -454,16 +496,16 @@ ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safe
     features.scores[F_pawnStruct] -= EvalConfig::rookBehindPassed * (countBit(rooks[Co_Black] & BBTools::rearSpan<Co_Black>(pe.passed[Co_Black])) - countBit(rooks[Co_White] & BBTools::rearSpan<Co_Black>(pe.passed[Co_Black])));
 
     // protected minor blocking openfile
-    features.scores[F_positional] += EvalConfig::minorOnOpenFile * countBit(pe.openFiles & (minor[Co_White]) & pe.pawnTargets[Co_White]);
-    features.scores[F_positional] -= EvalConfig::minorOnOpenFile * countBit(pe.openFiles & (minor[Co_Black]) & pe.pawnTargets[Co_Black]);
+    features.scores[F_positional] += EvalConfig::minorOnOpenFile * countBit(openFiles & (minor[Co_White]) & pawnTargets[Co_White]);
+    features.scores[F_positional] -= EvalConfig::minorOnOpenFile * countBit(openFiles & (minor[Co_Black]) & pawnTargets[Co_Black]);
 
     // knight on opponent hole, protected by pawn
-    features.scores[F_positional] += EvalConfig::outpostN * countBit(pe.holes[Co_Black] & knights[Co_White] & pe.pawnTargets[Co_White]);
-    features.scores[F_positional] -= EvalConfig::outpostN * countBit(pe.holes[Co_White] & knights[Co_Black] & pe.pawnTargets[Co_Black]);
+    features.scores[F_positional] += EvalConfig::outpostN * countBit(pe.holes[Co_Black] & knights[Co_White] & pawnTargets[Co_White]);
+    features.scores[F_positional] -= EvalConfig::outpostN * countBit(pe.holes[Co_White] & knights[Co_Black] & pawnTargets[Co_Black]);
 
     // bishop on opponent hole, protected by pawn
-    features.scores[F_positional] += EvalConfig::outpostB * countBit(pe.holes[Co_Black] & bishops[Co_White] & pe.pawnTargets[Co_White]);
-    features.scores[F_positional] -= EvalConfig::outpostB * countBit(pe.holes[Co_White] & bishops[Co_Black] & pe.pawnTargets[Co_Black]);
+    features.scores[F_positional] += EvalConfig::outpostB * countBit(pe.holes[Co_Black] & bishops[Co_White] & pawnTargets[Co_White]);
+    features.scores[F_positional] -= EvalConfig::outpostB * countBit(pe.holes[Co_White] & bishops[Co_Black] & pawnTargets[Co_Black]);
 
     // knight far from both kings gets a penalty
     BitBoard knight = knights[Co_White];
@@ -563,10 +605,10 @@ ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safe
     STOP_AND_SUM_TIMER(Eval5)
 
     // rook on open file
-    features.scores[F_positional] += EvalConfig::rookOnOpenFile         * countBit(rooks[Co_White] & pe.openFiles);
+    features.scores[F_positional] += EvalConfig::rookOnOpenFile         * countBit(rooks[Co_White] & openFiles);
     features.scores[F_positional] += EvalConfig::rookOnOpenSemiFileOur  * countBit(rooks[Co_White] & pe.semiOpenFiles[Co_White]);
     features.scores[F_positional] += EvalConfig::rookOnOpenSemiFileOpp  * countBit(rooks[Co_White] & pe.semiOpenFiles[Co_Black]);
-    features.scores[F_positional] -= EvalConfig::rookOnOpenFile         * countBit(rooks[Co_Black] & pe.openFiles);
+    features.scores[F_positional] -= EvalConfig::rookOnOpenFile         * countBit(rooks[Co_Black] & openFiles);
     features.scores[F_positional] -= EvalConfig::rookOnOpenSemiFileOur  * countBit(rooks[Co_Black] & pe.semiOpenFiles[Co_Black]);
     features.scores[F_positional] -= EvalConfig::rookOnOpenSemiFileOpp  * countBit(rooks[Co_Black] & pe.semiOpenFiles[Co_White]);
 
@@ -583,8 +625,9 @@ ScoreType eval(const Position & p, EvalData & data, Searcher &context, bool safe
     features.scores[F_positional] -= EvalConfig::rookQueenSameFile * countBit(BBTools::fillFile(queens[Co_Black]) & rooks[Co_Black]);
 
     // pins on king and queen
-    const BitBoard pinnedK [2] = { getPinned<Co_White>(p,p.king[Co_White]), getPinned<Co_Black>(p,p.king[Co_Black]) };
-    const BitBoard pinnedQ [2] = { getPinned<Co_White>(p,whiteQueenSquare), getPinned<Co_Black>(p,blackQueenSquare) };
+    const BitBoard pinnedK [2] = { getPinned(p,Co_White,p.king[Co_White]), getPinned(p,Co_Black,p.king[Co_Black]) };
+    const BitBoard pinnedQ [2] = { getPinned(p,Co_White,whiteQueenSquare), getPinned(p,Co_Black,blackQueenSquare) };
+
     for (Piece pp = P_wp ; pp < P_wk ; ++pp) {
         const BitBoard bw = p.pieces_const(Co_White, pp);
         if (bw) {
@@ -16,6 +16,8 @@ extern CONST_TEXEL_TUNING EvalScore imbalance_theirs[5][5];
 extern CONST_TEXEL_TUNING EvalScore secondOrderFeature[6][6];
 
 extern CONST_TEXEL_TUNING EvalScore PST[PieceShift][NbSquare];
+// PST value of piece pp on square k, from white point of view (used for Position::psq incremental update)
+[[nodiscard]] inline EvalScore PSTValue(Piece pp, Square k){ return pp > 0 ? PST[pp-1][k^56] : PST[-pp-1][k]*ScoreType(-1); }
 
 extern CONST_TEXEL_TUNING EvalScore   pawnShieldBonus        ;
 extern CONST_TEXEL_TUNING EvalScore   pawnFawnMalusKS        ;
@@ -3,7 +3,13 @@
 #include "definition.hpp"
 
 struct EvalData;
+struct EvalPartial;
 struct Position;
 struct Searcher;
 
-ScoreType eval(const Position & p, EvalData & data, Searcher &context,bool safeMatEvaluator = true, bool display = false, std::ostream * of = nullptr);
+// Evaluation is tiered : when [lazyAlpha,lazyBeta] is given (side to move point of view), cheap terms are computed first
+// (material and PST, then pawn structure) and evaluation stops as soon as they are far enough outside the window.
+// data.lazy is then set and the returned score is only an approximation.
+// If partial is given, a lazy exit saves the terms summed so far, and a later call with the same partial (and data) completes
+// the evaluation from there. The window is ignored for display and features output.
+ScoreType eval(const Position & p, EvalData & data, Searcher &context,bool safeMatEvaluator = true, bool display = false, std::ostream * of = nullptr, ScoreType lazyAlpha = -MATE, ScoreType lazyBeta = MATE, EvalPartial * partial = nullptr);
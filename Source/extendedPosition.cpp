@@ -6,6 +6,7 @@
 #include "moveGen.hpp"
 #include "positionTools.hpp"
 #include "searcher.hpp"
+#include "taskPool.hpp"
 #include "tools.hpp"
 
 #include <algorithm>
@@ -350,7 +351,7 @@ void ExtendedPosition::test(const std::vector<std::string> & positions,
       }
     };
 
-    threadedWork(worker,threads,positions.size());
+    TaskPool::instance().parallel_for(positions.size(),worker,threads,1);
 
     // display results
     int totalScore = 0;
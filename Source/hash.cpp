@@ -22,9 +22,10 @@ Hash computeHash(const Position &p){
 #endif
     if (p.h != nullHash) return p.h;
     //++ThreadPool::instance().main().stats.counters[Stats::sid_hashComputed]; // shall of course never happend !
-    for (Square k = 0; k < NbSquare; ++k){ ///todo try if BB is faster here ?
-        const Piece pp = p.board_const(k);
-        if ( pp != P_none) p.h ^= Zobrist::ZT[k][pp+PieceShift];
+    BitBoard bb = p.occupancy();
+    while (bb) { 
+        const Square k = popBit(bb);
+        p.h ^= Zobrist::ZT[k][p.board_const(k)+PieceShift];
     }
     if ( p.ep != INVALIDSQUARE ) p.h ^= Zobrist::ZT[p.ep][NbPiece];
     p.h ^= Zobrist::ZTCastling[p.castling];
@@ -4,16 +4,19 @@
 #include "logging.hpp"
 #include "position.hpp"
 
+#include "bitbaseData.hpp"
+
 namespace{
 constexpr unsigned KPKmaxIndex = 2*24*NbSquare*NbSquare; // Color x pawn x wk x bk
-uint32_t KPKBitbase[KPKmaxIndex/32]; // force 32bit uint
-inline unsigned KPKindex(Color us, Square bksq, Square wksq, Square psq) {
-  return wksq | (bksq << 6) | (us << 12) | (SQFILE(psq) << 13) | ((6 - SQRANK(psq)) << 15);
-}
+static_assert(sizeof(BitbaseData::KPK) == KPKmaxIndex/32*sizeof(uint32_t), "KPK bitbase data does not match index");
 }
 
 namespace KPK{
 
+unsigned index(Color us, Square bksq, Square wksq, Square psq) {
+  return wksq | (bksq << 6) | (us << 12) | (SQFILE(psq) << 13) | ((6 - SQRANK(psq)) << 15);
+}
+
 Square normalizeSquare(const Position& p, Color strongSide, Square sq) {
    assert(countBit(p.pieces_const<P_wp>(strongSide)) == 1); // only for KPK !
    if (SQFILE(BBTools::SquareFromBitBoard(p.pieces_const<P_wp>(strongSide))) >= File_e) sq = Square(HFlip(sq)); // we know there is at least one pawn
@@ -38,29 +41,30 @@ template<Color Us> kpk_result KPKPosition::preCompute(const std::vector<KPKPosit
     constexpr kpk_result bad  = (Us == Co_White ? kpk_draw : kpk_win);
     kpk_result r = kpk_invalid;
     BitBoard b = BBTools::mask[ksq[us]].king;
-    while (b){ r |= (Us == Co_White ? db[KPKindex(Them, ksq[Them], popBit(b), psq)] : db[KPKindex(Them, popBit(b), ksq[Them], psq)]); }
+    while (b){ r |= (Us == Co_White ? db[index(Them, ksq[Them], popBit(b), psq)] : db[index(Them, popBit(b), ksq[Them], psq)]); }
     if (Us == Co_White){
-        if (SQRANK(psq) < 6) r |= db[KPKindex(Them, ksq[Them], ksq[Us], psq + 8)];
-        if (SQRANK(psq) == 1 && psq + 8 != ksq[Us] && psq + 8 != ksq[Them]) r |= db[KPKindex(Them, ksq[Them], ksq[Us], psq + 8 + 8)];
+        if (SQRANK(psq) < 6) r |= db[index(Them, ksq[Them], ksq[Us], psq + 8)];
+        if (SQRANK(psq) == 1 && psq + 8 != ksq[Us] && psq + 8 != ksq[Them]) r |= db[index(Them, ksq[Them], ksq[Us], psq + 8 + 8)];
     }
     return result = r & good ? good : r & kpk_unknown ? kpk_unknown : bad;
 }
 
 bool probe(Square wksq, Square wpsq, Square bksq, Color us) {
     assert(SQFILE(wpsq) <= 4);
-    const unsigned idx = KPKindex(us, bksq, wksq, wpsq);
+    const unsigned idx = index(us, bksq, wksq, wpsq);
     assert(idx < KPKmaxIndex);
-    return KPKBitbase[idx/32] & (1<<(idx&0x1F));
+    return BitbaseData::KPK[idx/32] & (1<<(idx&0x1F));
 }
 
-void init(){
-    Logging::LogIt(Logging::logInfo) << "KPK init";
+void generate(std::vector<uint32_t> & bitbase){
+    Logging::LogIt(Logging::logInfo) << "KPK generation";
     Logging::LogIt(Logging::logInfo) << "KPK table size : " << KPKmaxIndex/32*sizeof(uint32_t)/1024 << "Kb";
     std::vector<KPKPosition> db(KPKmaxIndex);
     unsigned idx, repeat = 1;
     for (idx = 0; idx < KPKmaxIndex; ++idx) db[idx] = KPKPosition(idx); // init
     while (repeat) for (repeat = idx = 0; idx < KPKmaxIndex; ++idx) repeat |= (db[idx] == kpk_unknown && db[idx].preCompute(db) != kpk_unknown); // loop
-    for (idx = 0; idx < KPKmaxIndex; ++idx){ if (db[idx] == kpk_win) { KPKBitbase[idx / 32] |= 1 << (idx & 0x1F); } } // compress
+    bitbase.assign(KPKmaxIndex/32, 0u);
+    for (idx = 0; idx < KPKmaxIndex; ++idx){ if (db[idx] == kpk_win) { bitbase[idx / 32] |= 1 << (idx & 0x1F); } } // compress
 }
 
 } // KPK
@@ -7,6 +7,7 @@ struct Position;
 /*!
  * This KPK implementation idea was taken from public-domain code from H.G. Muller
  * http://talkchess.com/forum3/viewtopic.php?f=7&t=47557#p511740
+ * The bitbase is generated offline (see Bitbase::generate) and embedded inside the binary.
  */
 namespace KPK{
 
@@ -28,8 +29,11 @@ struct KPKPosition {
 };
 #pragma pack(pop)
 
+[[nodiscard]] unsigned index(Color us, Square bksq, Square wksq, Square psq);
+
 [[nodiscard]] bool probe(Square wksq, Square wpsq, Square bksq, Color us);
 
-void init();
+// compute the KPK bitbase (only used by the bitbase generator)
+void generate(std::vector<uint32_t> & bitbase);
 
 } // KPK
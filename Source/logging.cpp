@@ -4,32 +4,84 @@
 
 namespace Logging {
 
-    std::mutex LogIt::_mutex;
-    std::unique_ptr<std::ofstream> LogIt::_of;
-
     COMType ct = CT_uci;
 
-    std::string showDate() {
+    using DateClock = std::chrono::system_clock; // Clock is monotonic, not a calendar date
+
+    std::string showDate(const DateClock::time_point & date) {
         std::stringstream str;
-        auto msecEpoch = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now().time_since_epoch());
+        auto msecEpoch = std::chrono::duration_cast<std::chrono::milliseconds>(date.time_since_epoch());
         char buffer[64];
-        auto tt = Clock::to_time_t(Clock::time_point(msecEpoch));
+        auto tt = DateClock::to_time_t(DateClock::time_point(msecEpoch));
         std::strftime(buffer, 63, "%Y-%m-%d %H:%M:%S", localtime(&tt));
         str << buffer << "-" << std::setw(3) << std::setfill('0') << msecEpoch.count() % 1000;
         return str.str();
     }
 
+    namespace {
+        struct Line {
+            Line *            next;
+            LogLevel          level;
+            DateClock::time_point date;
+            std::string       text;
+        };
+
+        std::atomic<Line*> pending {nullptr};    // lock free stack of lines waiting for the writer (newest first)
+        std::mutex         outputMutex;          // held while writing to outputs
+        std::mutex         wakeUpMutex;
+        std::condition_variable wakeUp;
+        std::atomic<bool>  asyncOn {false};
+        std::thread        writer;
+        std::unique_ptr<std::ofstream> _of;      // debug file
+
+        void write(const Line & l){
+            if (l.level != logGUI) {
+                std::cout       << _protocolComment[ct] << _levelNames[l.level] << showDate(l.date) << ": " << l.text << "\n";
+                if (_of) (*_of) << _protocolComment[ct] << _levelNames[l.level] << showDate(l.date) << ": " << l.text << "\n";
+            }
+            else {
+                std::cout       << l.text << "\n";
+                if (_of) (*_of) << l.text << "\n";
+            }
+        }
+
+        // outputMutex must be held, lines are written in push order and outputs are flushed once per batch
+        void drain(){
+            Line * l = pending.exchange(nullptr, std::memory_order_acquire);
+            if (!l) return;
+            Line * ordered = nullptr;
+            while (l){ Line * next = l->next; l->next = ordered; ordered = l; l = next; }
+            while (ordered){ write(*ordered); Line * next = ordered->next; delete ordered; ordered = next; }
+            std::cout << std::flush;
+            if (_of) (*_of) << std::flush;
+        }
+
+        void writerLoop(){
+            while (asyncOn.load(std::memory_order_acquire)){
+                {
+                    std::unique_lock<std::mutex> lock(wakeUpMutex);
+                    wakeUp.wait_for(lock, std::chrono::milliseconds(10), []{ return pending.load(std::memory_order_relaxed) != nullptr || !asyncOn.load(std::memory_order_relaxed); });
+                }
+                const std::lock_guard<std::mutex> lock(outputMutex);
+                drain();
+            }
+        }
+    }
+
     LogIt::~LogIt() {
-        std::lock_guard<std::mutex> lock(_mutex);
-        if (_level != logGUI) {
-           if ( ! DynamicConfig::quiet || _level > logGUI ){
-              std::cout       << _protocolComment[ct] << _levelNames[_level] << showDate() << ": " << _buffer.str() << std::endl;
-              if (_of) (*_of) << _protocolComment[ct] << _levelNames[_level] << showDate() << ": " << _buffer.str() << std::endl;
-           }
+        if (!_buffer) return; // filtered
+        const bool sync = _level == logGUI || _level >= logError || !asyncOn.load(std::memory_order_acquire);
+        if (sync) {
+            const std::lock_guard<std::mutex> lock(outputMutex);
+            drain(); // keep ordering with pending lines
+            write(Line{nullptr, _level, DateClock::now(), _buffer->str()});
+            std::cout << std::flush;
+            if (_of) (*_of) << std::flush;
         }
         else {
-            std::cout       << _buffer.str() << std::flush << std::endl;
-            if (_of) (*_of) << _buffer.str() << std::flush << std::endl;
+            Line * l = new Line{pending.load(std::memory_order_relaxed), _level, DateClock::now(), _buffer->str()};
+            while (!pending.compare_exchange_weak(l->next, l, std::memory_order_release, std::memory_order_relaxed)) {}
+            wakeUp.notify_one();
         }
         if (_level >= logError) {
 #ifdef DEBUG_BACKTRACE
@@ -49,12 +101,30 @@ namespace Logging {
 #endif
     }
 
+    void flush(){
+        if (asyncOn.exchange(false)){
+            wakeUp.notify_one();
+            writer.join();
+        }
+        const std::lock_guard<std::mutex> lock(outputMutex);
+        drain();
+    }
+
     void init(){
         if ( DynamicConfig::debugMode ){
             if ( DynamicConfig::debugFile.empty()) DynamicConfig::debugFile = "minic.debug";
-            LogIt::_of = std::unique_ptr<std::ofstream>(new std::ofstream(DynamicConfig::debugFile + "_" + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now().time_since_epoch()).count())));
+            _of = std::unique_ptr<std::ofstream>(new std::ofstream(DynamicConfig::debugFile + "_" + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(DateClock::now().time_since_epoch()).count())));
         }
+    }
 
+    void startAsync(){
+        if (!asyncOn.exchange(true)){
+            writer = std::thread(writerLoop);
+            // atexit handlers and static destructors run in reverse order of registration/construction : as this is registered
+            // after most static objects are built, flush runs before their destructors (async is then off, so that lines logged
+            // from those destructors are written synchronously). Statics built later (function local ones) are destroyed before flush.
+            std::atexit(flush);
+        }
     }
 
 }
@@ -2,6 +2,8 @@
 
 #include "definition.hpp"
 
+#include "dynamicConfig.hpp"
+
 #ifdef __ANDROID__
 inline std::string backtrace(int skip = 1 ){
     ////@todo backtrace for android
@@ -86,6 +88,9 @@ std::string backtrace(int skip = 1) {
 
 /* A little logging facility
  * Can redirect non GUI output to file for debug purpose
+ * Filtered levels are not even formatted. In protocol mode (see startAsync) kept lines are pushed (lock free) to a writer thread,
+ * except GUI, error and fatal lines that are written immediately (after pending lines to keep ordering).
+ * Otherwise (command line tools, that also write directly to std::cout/std::cerr) all lines are written immediately.
  */
 namespace Logging {
     enum COMType { CT_xboard = 0, CT_uci = 1 };
@@ -94,20 +99,27 @@ namespace Logging {
     const std::string _protocolComment[2] = { "# ", "info string " };
     const std::string _levelNames[logMax] = { "Trace ", "Debug ", "Info  ", "", "Info  ", "Warn  ", "Error ", "Fatal " };
 
+    const LogLevel minLevel = logTrace; // compile time filter, lower levels are never formatted
+
+    [[nodiscard]] inline bool isActive(LogLevel level){ return level >= minLevel && (level >= logGUI || !DynamicConfig::quiet); }
+
     class LogIt {
-        friend void init();
     public:
-        LogIt(LogLevel loglevel):_level(loglevel){}
-        template <typename T> inline Logging::LogIt & operator<<(T const & value) { _buffer << value; return *this; }
+        LogIt(LogLevel loglevel):_level(loglevel){ if (isActive(loglevel)) _buffer.emplace(); }
+        template <typename T> inline Logging::LogIt & operator<<(T const & value) { if (_buffer) *_buffer << value; return *this; }
         ~LogIt();
     private:
-        static std::mutex      _mutex;
-        std::ostringstream     _buffer;
-        LogLevel               _level;
-        static std::unique_ptr<std::ofstream> _of;
+        std::optional<std::ostringstream> _buffer;
+        LogLevel                          _level;
     };
 
     void hellooo();
 
     void init();
+
+    // start the writer thread, only for UCI/XBoard modes where all output goes through LogIt
+    void startAsync();
+
+    // write all pending lines (called at exit)
+    void flush();
 }
@@ -1,6 +1,8 @@
 #include "material.hpp"
 
 #include "attack.hpp"
+#include "bitbase.hpp"
+#include "dynamicConfig.hpp"
 #include "evalConfig.hpp"
 #include "kpk.hpp"
 #include "logging.hpp"
@@ -139,6 +141,16 @@ namespace MaterialHash { // idea from Gull
        return ((winningSide == Co_White)?+1:-1)*(WIN + ValuesEG[P_wp+PieceShift] + 10*SQRANK(psq));
     }
 
+    ScoreType helperBitbase(Bitbase::BitbaseResult r, Color winningSide, ScoreType s){
+       if ( r == Bitbase::bb_unknown ) return helperUnknown;
+       if ( r == Bitbase::bb_draw ) return 0; // shall be drawScore but this is not a 3rep case so don't bother too much ...
+       return s + ((winningSide == Co_White)?+WIN:-WIN);
+    }
+
+    ScoreType helperKQKP(const Position &p, Color winningSide, ScoreType s){ return helperBitbase(Bitbase::probeKQKP(p, winningSide), winningSide, s); }
+    ScoreType helperKRKP(const Position &p, Color winningSide, ScoreType s){ return helperBitbase(Bitbase::probeKRKP(p, winningSide), winningSide, s); }
+    ScoreType helperKBPK(const Position &p, Color winningSide, ScoreType s){ return helperBitbase(Bitbase::probeKBPK(p, winningSide), winningSide, s); }
+
     // Second-degree polynomial material imbalance, by Tord Romstad (old version, not the current Stockfish stuff)
     EvalScore Imbalance(const Position::Material & mat, Color c) {
         EvalScore bonus = 0;
@@ -177,16 +189,72 @@ namespace MaterialHash { // idea from Gull
             const EvalScore imbalanceW = Imbalance(mat, Co_White);
             const EvalScore imbalanceB = Imbalance(mat, Co_Black);
 #endif
-            materialHashTable[k].gp = (matScoreW + matScoreB ) / totalMatScore;
+            materialHashTable[k].phase = (unsigned char)std::min(phaseScale, std::round(phaseScale * (matScoreW + matScoreB) / totalMatScore));
             materialHashTable[k].score = EvalScore(imbalanceW[MG] + matScoreW   - (imbalanceB[MG] + matScoreB), imbalanceW[EG] + matScoreWEG - (imbalanceB[EG] + matScoreBEG));
         }
         if ( display) Logging::LogIt(Logging::logInfo) << "...Done";
     }
 
+    // material table image header, the image is only valid for the piece values and imbalance it was built with
+    struct MaterialTableHeader{
+        uint32_t magic     = 0x4D4D4154; // "MMAT"
+        uint32_t version   = 1;
+        uint32_t entries   = TotalMat;
+        uint32_t entrySize = sizeof(MaterialHashEntry);
+        uint64_t inputHash = 0;
+    };
+
+    // FNV-1a of everything InitMaterialScore depends on
+    uint64_t materialInputHash(){
+        uint64_t h = 14695981039346656037ull;
+        auto add = [&h](const void * data, size_t size){ for (size_t k = 0 ; k < size ; ++k){ h ^= static_cast<const unsigned char*>(data)[k]; h *= 1099511628211ull; } };
+        add(Values, sizeof(Values));
+        add(ValuesEG, sizeof(ValuesEG));
+#ifndef WITH_TEXEL_TUNING
+        add(EvalConfig::imbalance_mines, sizeof(EvalConfig::imbalance_mines));
+        add(EvalConfig::imbalance_theirs, sizeof(EvalConfig::imbalance_theirs));
+#endif
+        return h;
+    }
+
+    bool readMaterialTable(const std::string & fileName){
+        std::ifstream str(fileName, std::ios::binary);
+        if (!str) return false;
+        MaterialTableHeader expected;
+        expected.inputHash = materialInputHash();
+        MaterialTableHeader header;
+        str.read(reinterpret_cast<char*>(&header), sizeof(MaterialTableHeader));
+        if ( !str || header.magic != expected.magic || header.version != expected.version || header.entries != expected.entries || header.entrySize != expected.entrySize || header.inputHash != expected.inputHash ){
+            Logging::LogIt(Logging::logWarn) << "Material table image " << fileName << " does not match current configuration";
+            return false;
+        }
+        str.read(reinterpret_cast<char*>(materialHashTable), sizeof(materialHashTable));
+        if (!str){
+            Logging::LogIt(Logging::logWarn) << "Material table image " << fileName << " is truncated";
+            return false;
+        }
+        return true;
+    }
+
+    bool writeMaterialTable(const std::string & fileName){
+        std::ofstream str(fileName, std::ios::binary);
+        if (!str){
+            Logging::LogIt(Logging::logError) << "Cannot open " << fileName;
+            return false;
+        }
+        MaterialTableHeader header;
+        header.inputHash = materialInputHash();
+        str.write(reinterpret_cast<const char*>(&header), sizeof(MaterialTableHeader));
+        str.write(reinterpret_cast<const char*>(materialHashTable), sizeof(materialHashTable));
+        Logging::LogIt(Logging::logInfo) << "Material table image written to " << fileName;
+        return bool(str);
+    }
+
     void MaterialHashInitializer::init() {
         Logging::LogIt(Logging::logInfo) << "Material hash total : " << TotalMat;
         Logging::LogIt(Logging::logInfo) << "Material hash size : " << TotalMat*sizeof(MaterialHashEntry)/1024/1024 << "Mb";
-        InitMaterialScore();
+        if ( !DynamicConfig::materialTableFile.empty() && readMaterialTable(DynamicConfig::materialTableFile) ) Logging::LogIt(Logging::logInfo) << "Material table image loaded from " << DynamicConfig::materialTableFile;
+        else InitMaterialScore();
         for(size_t k = 0 ; k < TotalMat ; ++k) helperTable[k] = &helperDummy;
 
 #define DEF_MAT(x,t)     const Position::Material MAT##x = materialFromString(TO_STR(x)); MaterialHashInitializer LINE_NAME(dummyMaterialInitializer,MAT##x)( MAT##x ,t   );
@@ -305,6 +373,12 @@ namespace MaterialHash { // idea from Gull
         // KPK
         DEF_MAT_H(KPK, Ter_WhiteWinWithHelper,&helperKPK)    DEF_MAT_REV_H(KKP,KPK,&helperKPK)
 
+        // bitbases (only the difficult part of those endgames is known, helpers fall back to standard eval otherwise)
+        DEF_MAT_H(KQKP, Ter_WhiteWinWithHelper,&helperKQKP)  DEF_MAT_REV_H(KPKQ,KQKP,&helperKQKP)
+        DEF_MAT_H(KRKP, Ter_WhiteWinWithHelper,&helperKRKP)  DEF_MAT_REV_H(KPKR,KRKP,&helperKRKP)
+        DEF_MAT_H(KLPK, Ter_WhiteWinWithHelper,&helperKBPK)  DEF_MAT_REV_H(KKLP,KLPK,&helperKBPK)
+        DEF_MAT_H(KDPK, Ter_WhiteWinWithHelper,&helperKBPK)  DEF_MAT_REV_H(KKDP,KDPK,&helperKBPK)
+
         ///@todo other (with more pawn ...), especially KPsKB with wrong Color bishop
 
     }
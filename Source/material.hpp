@@ -39,12 +39,17 @@ namespace MaterialHash {
     };
 
     extern ScoreType (* helperTable[TotalMat])(const Position &, Color, ScoreType );
+    const ScoreType helperUnknown = INFSCORE; // a helper returns this when it has no knowledge about the position
+
+    // game phase is stored on 8 bits, 255 being the starting position material (or more)
+    const float phaseScale = 255.f;
 
 #pragma pack(push, 1)
     struct MaterialHashEntry  {
       EvalScore score = {0,0};
-      float gp = 1.f;
+      unsigned char phase = (unsigned char)phaseScale;
       Terminaison t = Ter_Unknown;
+      [[nodiscard]] inline float gp()const{ return phase / phaseScale; }
     };
 #pragma pack(pop)    
 
@@ -54,6 +59,10 @@ namespace MaterialHash {
 
     void InitMaterialScore(bool display = true);
 
+    // material table image (computed offline with current piece values and imbalance, see "-genMaterialTable" command line)
+    [[nodiscard]] bool readMaterialTable(const std::string & fileName);
+    bool writeMaterialTable(const std::string & fileName);
+
     struct MaterialHashInitializer {
         MaterialHashInitializer(const Position::Material & mat, Terminaison t) { materialHashTable[getMaterialHash(mat)].t = t; }
         MaterialHashInitializer(const Position::Material & mat, Terminaison t, ScoreType (*helper)(const Position &, Color, ScoreType) ) { materialHashTable[getMaterialHash(mat)].t = t; helperTable[getMaterialHash(mat)] = helper; }
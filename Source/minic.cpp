@@ -2,13 +2,13 @@
 
 #include "attack.hpp"
 #include "bitboardTools.hpp"
+#include "book.hpp"
 #include "cli.hpp"
 #include "com.hpp"
 #include "dynamicConfig.hpp"
 #include "egt.hpp"
 #include "evalConfig.hpp"
 #include "hash.hpp"
-#include "kpk.hpp"
 #include "logging.hpp"
 #include "material.hpp"
 #include "nnue.hpp"
@@ -38,8 +38,8 @@ void init(int argc, char ** argv) {
 #ifdef WITH_MAGIC
     BBTools::MagicBB::initMagic();
 #endif
-    KPK::init();
     MaterialHash::MaterialHashInitializer::init();
+    Book::init();
     EvalConfig::initEval();
     ThreadPool::instance().setup();
 #ifdef WITH_SYZYGY
@@ -52,8 +52,6 @@ void init(int argc, char ** argv) {
 }
 
 int main(int argc, char ** argv) {
-    START_TIMER
-
     init(argc, argv);
 
 #ifdef WITH_TEST_SUITE
@@ -82,9 +80,8 @@ int main(int argc, char ** argv) {
     }
     else firstOption=argv[1];
     int ret = cliManagement(firstOption,argc,argv);
-    STOP_AND_SUM_TIMER(Total)
 #ifdef WITH_TIMER
-    Timers::Display();
+    if ( DynamicConfig::timers ) Timers::Display();
 #endif
     return ret;
 #else
@@ -102,10 +99,8 @@ int main(int argc, char ** argv) {
 
 #endif
 
-    STOP_AND_SUM_TIMER(Total)
-
 #ifdef WITH_TIMER
-    Timers::Display();
+    if ( DynamicConfig::timers ) Timers::Display();
 #endif
 
     return EXIT_SUCCESS;
@@ -41,7 +41,7 @@ namespace{
 }
 
 void movePiece(Position & p, Square from, Square to, Piece fromP, Piece toP, bool isCapture, Piece prom) {
-    START_TIMER
+    START_TIMER(MovePiece)
     const int fromId   = fromP + PieceShift;
     const int toId     = toP + PieceShift;
     const Piece toPnew = prom != P_none ? prom : fromP;
@@ -61,6 +61,10 @@ void movePiece(Position & p, Square from, Square to, Piece fromP, Piece toP, boo
     }
     BBTools::setBit  (p, to,   toPnew);
     _setBit(p.allPieces[fromP>0?Co_White:Co_Black],to);
+    // update PST score
+    p.psq -= EvalConfig::PSTValue(fromP,from);
+    if (toP != P_none) p.psq -= EvalConfig::PSTValue(toP,to);
+    p.psq += EvalConfig::PSTValue(toPnew,to);
     // update Zobrist hash
     p.h ^= Zobrist::ZT[from][fromId]; // remove fromP at from
     p.h ^= Zobrist::ZT[to][toIdnew]; // add fromP (or prom) at to
@@ -91,7 +95,7 @@ void movePiece(Position & p, Square from, Square to, Piece fromP, Piece toP, boo
 }
 
 void applyNull(Searcher & , Position & pN) {
-    START_TIMER
+    START_TIMER(Apply)
     pN.c = ~pN.c;
     pN.h ^= Zobrist::ZT[3][13];
     pN.h ^= Zobrist::ZT[4][13];
@@ -104,7 +108,7 @@ void applyNull(Searcher & , Position & pN) {
 }
 
 bool applyMove(Position & p, const Move & m, bool noValidation){
-    START_TIMER
+    START_TIMER(Apply)
     assert(VALIDMOVE(m));
 #ifdef DEBUG_MATERIAL
     Position previous = p;
@@ -160,6 +164,10 @@ bool applyMove(Position & p, const Move & m, bool noValidation){
         p.board(to) = fromP;
         p.board(epCapSq) = P_none;
 
+        p.psq -= EvalConfig::PSTValue(fromP,from);
+        p.psq -= EvalConfig::PSTValue(~fromP,epCapSq);
+        p.psq += EvalConfig::PSTValue(fromP,to);
+
         p.h ^= Zobrist::ZT[from][fromId]; // remove fromP at from
         p.h ^= Zobrist::ZT[epCapSq][(p.c == Co_White ? P_bp : P_wp) + PieceShift]; // remove captured pawn
         p.h ^= Zobrist::ZT[to][fromId]; // add fromP at to
@@ -254,11 +262,9 @@ bool applyMove(Position & p, const Move & m, bool noValidation){
         Logging::LogIt(Logging::logWarn) << ToString(p);
         Logging::LogIt(Logging::logWarn) << ToString(m);
         Logging::LogIt(Logging::logWarn) << ToString(p.lastMove);
-        Logging::LogIt(Logging::logWarn) << p2.Evaluator().white.active();
-        Logging::LogIt(Logging::logWarn) << p2.Evaluator().black.active();
+        p2.Evaluator().visit([](auto & e){ Logging::LogIt(Logging::logWarn) << e.white.active() << e.black.active(); });
         Logging::LogIt(Logging::logWarn) << "--------------------";
-        Logging::LogIt(Logging::logWarn) << p.Evaluator().white.active();
-        Logging::LogIt(Logging::logWarn) << p.Evaluator().black.active();
+        p.Evaluator().visit([](auto & e){ Logging::LogIt(Logging::logWarn) << e.white.active() << e.black.active(); });
         Logging::LogIt(Logging::logWarn) << backtrace();
     }
 #endif
@@ -275,6 +281,15 @@ bool applyMove(Position & p, const Move & m, bool noValidation){
     }
 #endif
 
+#ifdef DEBUG_PSQ
+    const EvalScore psq = computePSQ(p);
+    if ( p.psq[MG] != psq[MG] || p.psq[EG] != psq[EG] ){
+        Logging::LogIt(Logging::logWarn)  << "PST score update error";
+        Logging::LogIt(Logging::logWarn)  << "PST computed " << psq << " incrementally updated " << p.psq;
+        Logging::LogIt(Logging::logFatal) << "Last move " << ToString(p.lastMove) << " current move "  << ToString(m) << " " << ToString(p);
+    }
+#endif
+
 #ifdef DEBUG_BITBOARD
     int count_bb1 = countBit(p.occupancy());
     int count_bb2 = 0;
@@ -381,7 +396,7 @@ bool isPseudoLegal2(const Position & p, Move m) { // validate TT move
 #else
     #define PSEUDO_LEGAL_RETURN(b,r) { STOP_AND_SUM_TIMER(PseudoLegal) return b; }    
 #endif
-    START_TIMER
+    START_TIMER(PseudoLegal)
     if (!VALIDMOVE(m)) PSEUDO_LEGAL_RETURN(false,-1)
     const Square from = Move2From(m); assert(squareOK(from));
     const Piece fromP = p.board_const(from);
@@ -4,6 +4,7 @@
 
 #include "attack.hpp"
 #include "bitboardTools.hpp"
+#include "evalConfig.hpp"
 #include "hash.hpp"
 #include "logging.hpp"
 #include "positionTools.hpp"
@@ -124,7 +125,7 @@ void generateSquare(const Position & p, MoveList & moves, Square from){
 
 template < GenPhase phase = GP_all >
 void generate(const Position & p, MoveList & moves, bool doNotClear = false){
-    START_TIMER
+    START_TIMER(Generate)
     if (!doNotClear) moves.clear();
     BitBoard myPieceBBiterator = p.allPieces[p.c];
     while (myPieceBBiterator) generateSquare<phase>(p,moves,popBit(myPieceBBiterator));
@@ -149,7 +150,7 @@ void initCaslingPermHashTable(const Position & p);
 
 template < Color c>
 inline void movePieceCastle(Position & p, CastlingTypes ct, Square kingDest, Square rookDest){
-    START_TIMER
+    START_TIMER(MovePiece)
     const Piece pk = c==Co_White?P_wk:P_bk;
     const Piece pr = c==Co_White?P_wr:P_br;
     const CastlingRights ks = c==Co_White?C_wks:C_bks;
@@ -166,6 +167,10 @@ inline void movePieceCastle(Position & p, CastlingTypes ct, Square kingDest, Squ
     p.board(p.rooksInit[c][ct]) = P_none;
     p.board(kingDest) = pk;
     p.board(rookDest) = pr;
+    p.psq -= EvalConfig::PSTValue(pk,p.king[c]);
+    p.psq -= EvalConfig::PSTValue(pr,p.rooksInit[c][ct]);
+    p.psq += EvalConfig::PSTValue(pk,kingDest);
+    p.psq += EvalConfig::PSTValue(pr,rookDest);
     p.h ^= Zobrist::ZT[p.king[c]][pk+PieceShift];
     p.ph ^= Zobrist::ZT[p.king[c]][pk+PieceShift];
     p.h ^= Zobrist::ZT[p.rooksInit[c][ct]][pr+PieceShift];
@@ -13,12 +13,22 @@
  * 7°) killer 0, then killer 1, then killer 0 from previous move, then counter
  * 8°) other quiet based on various history score (from/to, piece/to, CMH)
  * 9°) bad cap
+ * Lazy SMP helper threads (not main, not co-searchers) add a small per-thread jitter at root to diversify the tree
  */
 
+namespace{
+    // deterministic in [0,63] for a given thread and move
+    [[nodiscard]] inline ScoreType rootJitter(size_t id, const Move m){
+        const uint32_t h = (uint32_t(Move2MiniMove(m)) ^ 0x9E3779B9u) * uint32_t(2*id+1) * 0x45D9F3Bu;
+        return ScoreType((h >> 16) & 63);
+    }
+}
+
 template< Color C>
-void MoveSorter::computeScore(Move & m)const{
+bool MoveSorter::computeScore(Move & m)const{
     assert(VALIDMOVE(m));
-    if ( Move2Score(m) != 0 ) return; // prob cut already computed captures score
+    if ( Move2Score(m) != 0 ) return false; // prob cut already computed captures score
+    bool withHistory = false;
     const MType  t    = Move2Type(m); assert(moveTypeOK(t));
     const Square from = Move2From(m); assert(squareOK(from));
     const Square to   = Move2To(m); assert(squareOK(to));
@@ -55,10 +65,8 @@ void MoveSorter::computeScore(Move & m)const{
             else if (VALIDMOVE(p.lastMove) && sameMove(context.counterT.counter[Move2From(p.lastMove)][Move2To(p.lastMove)],m)) s+= 1300; // quiet counter
             else {
                 ///@todo give another try to tune those !
+                withHistory = true; // history scores (+/- HISTORY_MAX = 1000) are added afterwards for all quiet moves at once (see score)
                 const Piece pp = p.board_const(from);
-                s += context.historyT.history[p.c][from][to] /3; // +/- HISTORY_MAX = 1000
-                s += context.historyT.historyP[pp +PieceShift][to] /3 ; // +/- HISTORY_MAX = 1000
-                s += context.getCMHScore(p, from, to, cmhPtr) /3; // +/- HISTORY_MAX = 1000
                 if ( !isInCheck ){
                    if ( refutation != INVALIDMINIMOVE && from == Move2To(refutation) && context.SEE_GE(p,m,-80)) s += 1000; // move (safely) leaving threat square from null move search
                    const EvalScore * const pst = EvalConfig::PST[std::abs(pp) - 1];
@@ -67,23 +75,85 @@ void MoveSorter::computeScore(Move & m)const{
             }
         }
     }
+    if ( ply == 0 && !context.isMainThread() && context.id() < MAX_THREADS && !sameMove(context.previousBest,m) ) s += rootJitter(context.id(),m);
     m = ToMove(from, to, t, s);
+    return withHistory;
+}
+
+namespace{
+    // quiet moves history data are gathered in SoA arrays so that the sum is a simple vectorizable loop
+    struct QuietHistoryBatch{
+        size_t n = 0;
+        alignas(32) std::array<ScoreType,MAX_MOVE> h, hp, cmh0, cmh1, sum;
+        std::array<uint8_t,MAX_MOVE> idx;
+
+        void gather(const HistoryT & historyT, const CMHPtrArray & cmhPtr, const Position & p, const MoveList & moves){
+            for(size_t i = 0 ; i < n ; ++i){
+                const Move m = moves[idx[i]];
+                const Square from = Move2From(m);
+                const Square to   = Move2To(m);
+                const Piece pp    = p.board_const(from);
+                const int cmhIdx  = CMHIdx(pp,to);
+                h[i]    = historyT.history[p.c][from][to];
+                hp[i]   = historyT.historyP[pp+PieceShift][to];
+                cmh0[i] = cmhPtr[0] ? cmhPtr[0][cmhIdx] : 0;
+                cmh1[i] = cmhPtr[1] ? cmhPtr[1][cmhIdx] : 0;
+            }
+        }
+
+        void compute(){
+            #pragma omp simd
+            for(size_t i = 0 ; i < n ; ++i) sum[i] = ScoreType(h[i]/3 + hp[i]/3 + ScoreType(cmh0[i]+cmh1[i])/3);
+        }
+
+        void apply(MoveList & moves)const{
+            for(size_t i = 0 ; i < n ; ++i){
+                Move & m = moves[idx[i]];
+                m = ToMove(Move2From(m), Move2To(m), Move2Type(m), ScoreType(Move2Score(m) + sum[i]));
+            }
+        }
+    };
+
+    // insertion sort is faster than std::sort for the usual (small) move lists
+    const size_t insertionSortMaxSize = 64;
+
+    // pickNext : first moves are selected by a simple scan (often enough in cut nodes), for big lists that are
+    // still being picked after that (probably an all node) the remaining moves are sorted once
+    const size_t pickSortMinSize = 16;
+    const size_t pickScanCount   = 3;
+
+    void insertionSort(MoveList & moves){
+        const MoveSortOperator better;
+        for(size_t i = 1 ; i < moves.size() ; ++i){
+            const Move m = moves[i];
+            size_t j = i;
+            for( ; j > 0 && better(m,moves[j-1]) ; --j) moves[j] = moves[j-1];
+            moves[j] = m;
+        }
+    }
 }
 
 void MoveSorter::score(const Searcher & context, MoveList & moves, const Position & p, float gp, DepthType ply, const CMHPtrArray & cmhPtr, bool useSEE, bool isInCheck, const TT::Entry * e, const MiniMove refutation){
-    START_TIMER
+    START_TIMER(MoveScoring)
     if ( moves.size() < 2) return;
     const MoveSorter ms(context,p,gp,ply,cmhPtr,useSEE,isInCheck,e,refutation);
+    QuietHistoryBatch batch;
+    assert(moves.size() <= MAX_MOVE);
     if ( p.c == Co_White ){
-       for(auto it = moves.begin() ; it != moves.end() ; ++it){ 
-          ms.computeScore<Co_White>(*it); 
+       for(size_t k = 0 ; k < moves.size() ; ++k){ 
+          if ( ms.computeScore<Co_White>(moves[k]) ) batch.idx[batch.n++] = uint8_t(k);
        }
     }
     else{
-       for(auto it = moves.begin() ; it != moves.end() ; ++it){ 
-          ms.computeScore<Co_Black>(*it); 
+       for(size_t k = 0 ; k < moves.size() ; ++k){ 
+          if ( ms.computeScore<Co_Black>(moves[k]) ) batch.idx[batch.n++] = uint8_t(k);
        }
     }
+    if ( batch.n ){
+       batch.gather(context.historyT,cmhPtr,p,moves);
+       batch.compute();
+       batch.apply(moves);
+    }
     STOP_AND_SUM_TIMER(MoveScoring)
 }
 
@@ -93,16 +163,21 @@ void MoveSorter::scoreAndSort(const Searcher & context, MoveList & moves, const
 }
 
 void MoveSorter::sort(MoveList & moves){
-    START_TIMER
-    std::sort(moves.begin(),moves.end(),MoveSortOperator());
+    START_TIMER(MoveSorting)
+    if ( moves.size() <= insertionSortMaxSize ) insertionSort(moves);
+    else std::sort(moves.begin(),moves.end(),MoveSortOperator());
     STOP_AND_SUM_TIMER(MoveSorting)
 }
 
 const Move * MoveSorter::pickNext(MoveList & moves, size_t & begin){
     if ( moves.begin()+begin == moves.end()) return nullptr;
-    START_TIMER
-    auto it = std::min_element(moves.begin()+begin,moves.end(),MoveSortOperator());
-    std::iter_swap(moves.begin()+begin,it);
+    START_TIMER(MoveSorting)
+    // calls are sequential from begin = 0 on an unchanged list, so the list is already sorted after pickScanCount
+    if ( moves.size() <= pickSortMinSize || begin < pickScanCount ){
+       auto it = std::min_element(moves.begin()+begin,moves.end(),MoveSortOperator());
+       std::iter_swap(moves.begin()+begin,it);
+    }
+    else if ( begin == pickScanCount ) std::sort(moves.begin()+begin,moves.end(),MoveSortOperator());
     STOP_AND_SUM_TIMER(MoveSorting)
     return &*(moves.begin()+(begin++)); // increment begin !
 }
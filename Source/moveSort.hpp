@@ -29,8 +29,9 @@ struct MoveSorter{
             assert(e==NULL||e->h!=nullHash);
     }
 
+    // returns true if quiet move history scores are still to be added (see score)
     template<Color C>
-    void computeScore(Move & m)const;
+    [[nodiscard]] bool computeScore(Move & m)const;
 
     const Position & p;
     const TT::Entry * e;
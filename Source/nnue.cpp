@@ -17,6 +17,33 @@
 // see compute_scaling
 int NNUEWrapper::NNUEscaling = 64; // from 32 to 128      x_scaled = x * NNUEscaling / 64
 
+#ifdef EMBEDDEDNNUEPATH
+// The default net is included by the assembler inside the binary read-only data (see Tools/build.sh).
+// It is padded so that, for a net with a header, input layer weights start on a cache line and are used in place.
+#if defined(__APPLE__)
+   #define EMBEDDEDNNUESECTION ".const_data"
+   #define EMBEDDEDNNUESYMBOL(x) "_" #x
+#elif defined(_WIN32)
+   #define EMBEDDEDNNUESECTION ".section .rdata,\"dr\""
+   #define EMBEDDEDNNUESYMBOL(x) #x
+#else
+   #define EMBEDDEDNNUESECTION ".section .rodata"
+   #define EMBEDDEDNNUESYMBOL(x) #x
+#endif
+asm(EMBEDDEDNNUESECTION "\n"
+    ".balign 64\n"
+    ".skip 24\n" // 64 - sizeof(net_header)
+    ".globl " EMBEDDEDNNUESYMBOL(embeddedNNUEBegin) "\n"
+    EMBEDDEDNNUESYMBOL(embeddedNNUEBegin) ":\n"
+    ".incbin \"" EMBEDDEDNNUEPATH "\"\n"
+    ".globl " EMBEDDEDNNUESYMBOL(embeddedNNUEEnd) "\n"
+    EMBEDDEDNNUESYMBOL(embeddedNNUEEnd) ":\n"
+    ".byte 0\n"
+    ".text\n");
+extern "C" const char embeddedNNUEBegin[];
+extern "C" const char embeddedNNUEEnd[];
+#endif
+
 namespace NNUEWrapper{
 
 void compute_scaling(int count){
@@ -86,6 +113,54 @@ void compute_scaling(int count){
     DynamicConfig::disableTT = bkTT;
 }
 
+void evaluateBatch(const Position * positions, size_t n, ScoreType * scores){
+    // evaluators of the loaded net architecture
+    NNUEEvaluator::dispatch([&](auto tag){
+        using E = typename decltype(tag)::type;
+        E evaluators[E::batch_size];
+        Color sides[E::batch_size];
+        float out[E::batch_size];
+        for(size_t k = 0; k < n; k += E::batch_size){
+            const size_t m = std::min(E::batch_size, n - k);
+            for(size_t i = 0; i < m; ++i){
+                positions[k+i].resetNNUEEvaluator_(evaluators[i]);
+                sides[i] = positions[k+i].c;
+            }
+            E::propagate_batch(evaluators, sides, out, m);
+            for(size_t i = 0; i < m; ++i) scores[k+i] = ScoreType((ScoreType(out[i]) * NNUEscaling) / 64);
+        }
+    });
+}
+
+void init(){
+    bool loaded = false;
+    int scaling = 0;
+    if ( !DynamicConfig::NNUEFile.empty() ){
+       Logging::LogIt(Logging::logInfoPrio) << "Loading NNUE net " << DynamicConfig::NNUEFile;
+       loaded = NNUEEvaluator::load(DynamicConfig::NNUEFile, scaling);
+       if ( !loaded ) Logging::LogIt(Logging::logInfoPrio) << "Fail to load NNUE net " << DynamicConfig::NNUEFile;
+    }
+#ifdef EMBEDDEDNNUEPATH
+    if ( !loaded ){
+       Logging::LogIt(Logging::logInfoPrio) << "Loading embedded NNUE net " << EMBEDDEDNNUEPATH;
+       loaded = NNUEEvaluator::load(embeddedNNUEBegin, size_t(embeddedNNUEEnd - embeddedNNUEBegin), "embedded", scaling);
+       if ( !loaded ) Logging::LogIt(Logging::logInfoPrio) << "Fail to load embedded NNUE net";
+    }
+#endif
+    if ( loaded ){
+       DynamicConfig::useNNUE = true;
+       if ( scaling > 0 ){
+          NNUEscaling = scaling;
+          Logging::LogIt(Logging::logInfo) << "NNUEscaling " << NNUEscaling << " from net header";
+       }
+       else compute_scaling();
+    }
+    else{
+       Logging::LogIt(Logging::logInfoPrio) << "No NNUE net loaded, using standard evaluation";
+       DynamicConfig::useNNUE = false;
+    }
+}
+
 } // NNUEWrapper
 
 #endif // WITH_NNUE
@@ -14,6 +14,8 @@
    #define SCALINGCOUNT 50000
 #endif
 
+struct Position;
+
 // Internal wrapper to the NNUE things
 namespace NNUEWrapper{
 
@@ -25,29 +27,17 @@ namespace NNUEWrapper{
 
   void compute_scaling(int count = SCALINGCOUNT);
 
-  inline void init(){
-     if ( !DynamicConfig::NNUEFile.empty() ){
-        Logging::LogIt(Logging::logInfoPrio) << "Loading NNUE net " << DynamicConfig::NNUEFile;
-        if ( nnue::half_kp_weights<nnueNType,quantization>{}.load(
-                     DynamicConfig::NNUEFile, 
-                     nnue::half_kp_eval<nnueNType,quantization>::weights)){
-           DynamicConfig::useNNUE = true;
-           compute_scaling();
-        }
-        else{
-           Logging::LogIt(Logging::logInfoPrio) << "Fail to load NNUE net, using standard evaluation";
-           DynamicConfig::useNNUE = false;
-        }
-     }
-     else{
-        Logging::LogIt(Logging::logInfoPrio) << "No NNUE net loaded, using standard evaluation";
-        DynamicConfig::useNNUE = false;
-     }
-  }
+  // load NNUEFile if given, else the embedded net if any (see EMBEDDEDNNUEPATH)
+  void init();
+
+  // NNUE score (side to move point of view, scaled by NNUEscaling, without classic eval endgame scaling nor contempt)
+  // of n positions at once, for offline scoring
+  void evaluateBatch(const Position * positions, size_t n, ScoreType * scores);
 
 } // NNUEWrapper
 
-using NNUEEvaluator = nnue::half_kp_eval<NNUEWrapper::nnueNType,NNUEWrapper::quantization>;
+// the architecture of the loaded net is selected at runtime among those compiled (see NNUE_BASE_DIM)
+using NNUEEvaluator = nnue::half_kp_eval_dispatch<NNUEWrapper::nnueNType,NNUEWrapper::quantization,nnue::small_arch,nnue::default_arch,nnue::large_arch>;
 
 namespace feature_idx{
 
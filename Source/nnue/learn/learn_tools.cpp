@@ -390,6 +390,7 @@ int set_from_packed_sfen(Position &p, PackedSfen& sfen ){
 
 	BBTools::setBitBoards(p);
 	MaterialHash::initMaterial(p);
+	p.psq = computePSQ(p); // incremental PST score, as readFEN does
 	p.h = computeHash(p);
 	p.ph = computePHash(p);
 
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <string>
 #include <utility>
+#include <variant>
 
 // Taken from Seer version 1 implementation.
 // But now uses different architecture. Especially quantization.
@@ -61,9 +62,48 @@ inline void quantizationInfo(){
    Logging::LogIt(Logging::logInfo) << "outFactor    " <<  Quantization<true>::outFactor;
 }
 
+// read only stream over a memory buffer (an embedded net for instance)
+struct memory_buffer : public std::streambuf{
+  memory_buffer(const char * data, size_t size){ char * d = const_cast<char*>(data); setg(d, d, d + size); } // never written
+
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override {
+    char * target = (dir == std::ios_base::beg ? eback() : dir == std::ios_base::cur ? gptr() : egptr()) + off;
+    if ( target < eback() || target > egptr() ) return pos_type(off_type(-1));
+    setg(eback(), target, egptr());
+    return pos_type(target - eback());
+  }
+  pos_type seekpos(pos_type pos, std::ios_base::openmode mode) override { return seekoff(off_type(pos), std::ios_base::beg, mode); }
+};
+
 template<typename NT>
 struct weights_streamer{
-  std::fstream file;
+  std::ifstream fileStream;
+  memory_buffer memory {nullptr, 0};
+  std::istream  file;
+  const char *  data = nullptr; // not null when streaming from memory, then values can be mapped instead of copied
+  size_t        dataSize = 0;
+  uint32_t checksum = 2166136261u; // FNV-1a of everything read through readElement or map
+
+  void hash(const char * begin, const char * end){
+    for(const char * c = begin; c != end; ++c){ checksum = (checksum ^ uint8_t(*c)) * 16777619u; }
+  }
+
+  void readElement(std::array<char, sizeof(NT)> & element){
+    file.read(element.data(), element.size());
+    hash(element.data(), element.data() + element.size());
+  }
+
+  // zero-copy access to the next bytes of a memory stream, nullptr if not available
+  const char * map(const size_t bytes){
+    const auto pos = file.tellg();
+    if ( !data || pos < 0 || size_t(pos) + bytes > dataSize ) return nullptr;
+    const char * begin = data + size_t(pos);
+    file.seekg(bytes, std::ios_base::cur);
+    hash(begin, begin + bytes);
+    return begin;
+  }
+
+  [[nodiscard]] bool ok() const { return data || fileStream.is_open(); }
   
   template<typename T, bool Q>
   weights_streamer<NT>& streamW(T* dst, const size_t request){
@@ -73,7 +113,7 @@ struct weights_streamer{
     const float Wscale = Quantization<Q>::weightFactor;
     Logging::LogIt(Logging::logInfo) << "Reading inner weight";
     for(size_t i(0); i < request; ++i){
-      file.read(single_element.data(), single_element.size());
+      readElement(single_element);
       NT tmp{0};
       std::memcpy(&tmp, single_element.data(), single_element.size());
       dst[i] = Q? T( Quantization<Q>::round(Wscale * std::clamp(tmp,NT(-Quantization<Q>::weightMax),NT(Quantization<Q>::weightMax)) )) : tmp;
@@ -93,7 +133,7 @@ struct weights_streamer{
     const float Wscale = Quantization<Q>::weightScale;
     Logging::LogIt(Logging::logInfo) << "Reading input weight";
     for(size_t i(0); i < request; ++i){
-      file.read(single_element.data(), single_element.size());
+      readElement(single_element);
       NT tmp{0};
       std::memcpy(&tmp, single_element.data(), single_element.size());
       if ( Q && std::abs(tmp*Wscale) > (NT)std::numeric_limits<T>::max()) Logging::LogIt(Logging::logWarn) << "Overflow weight " << tmp << " " << (long long int)(Wscale * tmp);      
@@ -113,7 +153,7 @@ struct weights_streamer{
     const float Bscale = Quantization<Q>::biasFactor;
     Logging::LogIt(Logging::logInfo) << "Reading inner bias";
     for(size_t i(0); i < request; ++i){
-      file.read(single_element.data(), single_element.size());
+      readElement(single_element);
       NT tmp{0};
       std::memcpy(&tmp, single_element.data(), single_element.size());
       if ( Q && std::abs(tmp*Bscale) > (NT)std::numeric_limits<T>::max()) Logging::LogIt(Logging::logWarn) << "Overflow bias " << tmp << " " << (long long int)(Bscale * tmp);
@@ -133,7 +173,7 @@ struct weights_streamer{
     const float Bscale = Quantization<Q>::weightScale;
     Logging::LogIt(Logging::logInfo) << "Reading input bias";
     for(size_t i(0); i < request; ++i){
-      file.read(single_element.data(), single_element.size());
+      readElement(single_element);
       NT tmp{0};
       std::memcpy(&tmp, single_element.data(), single_element.size());
       if ( Q && std::abs(tmp*Bscale) > (NT)std::numeric_limits<T>::max()) Logging::LogIt(Logging::logWarn) << "Overflow bias " << tmp << " " << (long long int)(Bscale * tmp);
@@ -145,7 +185,8 @@ struct weights_streamer{
     return *this;
   }  
 
-  weights_streamer(const std::string& name) : file(name, std::ios_base::in | std::ios_base::binary) {}
+  weights_streamer(const std::string& name) : fileStream(name, std::ios_base::in | std::ios_base::binary), file(fileStream.rdbuf()) {}
+  weights_streamer(const char * buffer, size_t size) : memory(buffer, size), file(&memory), data(buffer), dataSize(size) {}
 };
 
 template<typename T, bool Q>
@@ -315,6 +356,42 @@ struct stack_affine{
     return result;
   }
 
+  // same as forward but only the non zero input lanes are accumulated,
+  // input is scanned by blocks first (this is good after a clipped relu where many lanes are 0).
+  // W is already stored input row major (W + i * dim1 is the row of input i) so no transposition is needed
+  template<typename T>
+  stack_vector<BT, dim1> forward_sparse(const stack_vector<T, dim0>& x) const {
+    static constexpr size_t block = 16;
+    static_assert(dim0 % block == 0, "sparse forward needs a dim0 multiple of block size");
+    uint16_t nz[dim0];
+    size_t nnz = 0;
+    for(size_t k = 0; k < dim0; k += block){
+      bool any = false;
+      #pragma omp simd reduction(|:any)
+      for(size_t i = k; i < k + block; ++i){ any |= x.data[i] != T{0}; }
+      if ( !any ) continue;
+      for(size_t i = k; i < k + block; ++i){ nz[nnz] = uint16_t(i); nnz += x.data[i] != T{0}; } // branchless
+    }
+    auto result = stack_vector<BT, dim1>::from(b);
+    for(size_t n = 0; n < nnz; ++n){
+      result.fma_(x.data[nz[n]], W + nz[n] * dim1);
+    }
+    return result;
+  }
+
+  // forward of n inputs at once (a small matrix-matrix product) : each row of W is loaded once for the whole batch.
+  // Zero input lanes are not skipped here, branching for each input of the batch costs more than it saves
+  template<typename T>
+  void forward_batch(const stack_vector<T, dim0>* x, stack_vector<BT, dim1>* out, const size_t n) const {
+    for(size_t p = 0; p < n; ++p){ out[p] = stack_vector<BT, dim1>::from(b); }
+    for(size_t i = 0; i < dim0; ++i){
+      const WT* row = W + i * dim1;
+      for(size_t p = 0; p < n; ++p){
+        out[p].fma_(x[p].data[i], row);
+      }
+    }
+  }
+
   stack_affine<NT, dim0, dim1, Q>& load_(weights_streamer<NT>& ws){
     ws.template streamW<WT, Q>(W, W_numel).template streamB<BT, Q>(b, b_numel);
     return *this;
@@ -332,6 +409,7 @@ struct big_affine{
   // dirty thing here, big_affine is always for input layer
   typename Quantization<Q>::WIT* W{nullptr};
   NNUEALIGNMENT typename Quantization<Q>::BIT b[b_numel];
+  bool ownsW = true; // false when W is mapped to an embedded net (read only memory !)
 
   void insert_idx(const size_t idx, stack_vector<BIT, b_numel>& x) const {
     const WIT* mem_region = W + idx * dim1;
@@ -344,11 +422,25 @@ struct big_affine{
   }
 
   big_affine<NT, dim0, dim1, Q>& load_(weights_streamer<NT>& ws){
+    // when the stored values are already the one used at runtime, a memory stream is used in place
+    if constexpr ( !Q && std::is_same<NT,WIT>::value ){
+      if ( ws.data && reinterpret_cast<uintptr_t>(ws.data + size_t(ws.file.tellg())) % 64 == 0 ){
+        if ( const char * mapped = ws.map(W_numel*sizeof(NT)) ){
+          Logging::LogIt(Logging::logInfo) << "Mapping input weight";
+          if ( ownsW ) delete[] W;
+          W = const_cast<WIT*>(reinterpret_cast<const WIT*>(mapped));
+          ownsW = false;
+          ws.template streamBI<BIT, Q>(b, b_numel);
+          return *this;
+        }
+      }
+    }
     ws.template streamWI<WIT, Q>(W, W_numel).template streamBI<BIT, Q>(b, b_numel);
     return *this;
   }
 
   big_affine<NT, dim0, dim1, Q>& operator=(const big_affine<NT, dim0, dim1, Q>& other){
+    if ( !ownsW ){ W = new WIT[W_numel]; ownsW = true; }
     #pragma omp simd
     for(size_t i = 0; i < W_numel; ++i){ W[i] = other.W[i]; }
     #pragma omp simd
@@ -359,6 +451,7 @@ struct big_affine{
   big_affine<NT, dim0, dim1, Q>& operator=(big_affine<NT, dim0, dim1, Q>&& other){
     std::swap(W, other.W);
     std::swap(b, other.b);
+    std::swap(ownsW, other.ownsW);
     return *this;
   }
 
@@ -373,28 +466,98 @@ struct big_affine{
   big_affine(big_affine<NT, dim0, dim1, Q>&& other){
     std::swap(W, other.W);
     std::swap(b, other.b);
+    std::swap(ownsW, other.ownsW);
   }
   
   big_affine(){ W = new WIT[W_numel]; }
 
-  ~big_affine(){ if(W != nullptr){ delete[] W; } }
+  ~big_affine(){ if(W != nullptr && ownsW){ delete[] W; } }
 };
 
 constexpr size_t half_ka_numel = 12*64*64;
-constexpr size_t base_dim = 128;
 
-template<typename NT, bool Q>
+// Net topology : half-KA input transformer (one per side) then 3 inner layers
+// with skip connections (each layer input is spliced with the previous ones) and 1 output
+template<size_t BASE_DIM, size_t FC0_DIM = 32, size_t FC1_DIM = 32, size_t FC2_DIM = 32>
+struct half_kp_arch{
+  static constexpr uint32_t id = 1; // architecture family identifier in net header
+  static constexpr size_t base_dim = BASE_DIM;
+  static constexpr size_t fc0_in   = 2*base_dim;
+  static constexpr size_t fc0_out  = FC0_DIM;
+  static constexpr size_t fc1_out  = FC1_DIM;
+  static constexpr size_t fc2_in   = fc0_out + fc1_out;
+  static constexpr size_t fc2_out  = FC2_DIM;
+  static constexpr size_t fc3_in   = fc2_in + fc2_out;
+  static constexpr std::array<uint32_t,4> dims = {uint32_t(base_dim), uint32_t(fc0_out), uint32_t(fc1_out), uint32_t(fc2_out)};
+  // number of values inside the net file (header excluded)
+  static constexpr size_t numel = 2*(half_ka_numel*base_dim + base_dim) + (fc0_in*fc0_out + fc0_out) + (fc0_out*fc1_out + fc1_out) + (fc2_in*fc2_out + fc2_out) + (fc3_in + 1);
+};
+
+// the architectures compiled in this binary, the one of the loaded net is selected at runtime (see half_kp_eval_dispatch) :
+// small nets are faster (short time control), large ones are stronger (analysis)
+#ifndef NNUE_BASE_DIM
+#define NNUE_BASE_DIM 128
+#endif
+typedef half_kp_arch<NNUE_BASE_DIM/2> small_arch;
+typedef half_kp_arch<NNUE_BASE_DIM>   default_arch;
+typedef half_kp_arch<NNUE_BASE_DIM*2> large_arch;
+
+// Optional versioned header at the beginning of a net file (older nets have none)
+struct net_header{
+  static constexpr uint32_t expectedMagic  = 0x45554E4E; // "NNUE"
+  static constexpr uint32_t currentVersion = 1;
+  uint32_t magic        = expectedMagic;
+  uint32_t version      = currentVersion;
+  uint32_t archId       = 0;
+  uint32_t dims[4]      = {0,0,0,0};
+  uint32_t quantization = 0; // storage scheme of values, only 0 (float32) for now, quantization is done at load time
+  int32_t  scaling      = 0; // NNUEscaling to be used with this net, 0 means automatic computation
+  uint32_t checksum     = 0; // FNV-1a of all the values following the header
+
+  template<typename Arch>
+  [[nodiscard]] bool matches() const {
+    return archId == Arch::id && std::equal(std::begin(dims), std::end(dims), Arch::dims.begin()) && quantization == 0;
+  }
+};
+static_assert(sizeof(net_header) == 40, "net header layout shall not change");
+
+// write a versioned header in front of a header less net
+template<typename NT, typename Arch>
+bool add_header(const std::string & in, const std::string & out, int32_t scaling){
+  std::ifstream is(in, std::ios::binary);
+  std::vector<char> payload((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+  if ( payload.size() != Arch::numel*sizeof(NT) ){
+    Logging::LogIt(Logging::logError) << "File " << in << " is not a header less net of the compiled architecture";
+    return false;
+  }
+  net_header header;
+  header.archId  = Arch::id;
+  std::copy(Arch::dims.begin(), Arch::dims.end(), header.dims);
+  header.scaling = scaling;
+  header.checksum = 2166136261u;
+  for(const char c : payload){ header.checksum = (header.checksum ^ uint8_t(c)) * 16777619u; }
+  std::ofstream os(out, std::ios::binary);
+  os.write(reinterpret_cast<const char*>(&header), sizeof(net_header));
+  os.write(payload.data(), payload.size());
+  if ( !os ){
+    Logging::LogIt(Logging::logError) << "Cannot write " << out;
+    return false;
+  }
+  Logging::LogIt(Logging::logInfo) << "Net written to " << out << " (scaling " << scaling << ", checksum " << header.checksum << ")";
+  return true;
+}
+
+template<typename NT, bool Q, typename Arch = default_arch>
 struct half_kp_weights{
-  big_affine  <NT, half_ka_numel, base_dim, Q> w{};
-  big_affine  <NT, half_ka_numel, base_dim, Q> b{};
-  stack_affine<NT, 2*base_dim   , 32      , Q> fc0{};
-  stack_affine<NT, 32           , 32      , Q> fc1{};
-  stack_affine<NT, 64           , 32      , Q> fc2{};
-  stack_affine<NT, 96           , 1       , Q> fc3{};
-
-  half_kp_weights<NT,Q>& load(weights_streamer<NT>& ws){
+  big_affine  <NT, half_ka_numel, Arch::base_dim, Q> w{};
+  big_affine  <NT, half_ka_numel, Arch::base_dim, Q> b{};
+  stack_affine<NT, Arch::fc0_in , Arch::fc0_out , Q> fc0{};
+  stack_affine<NT, Arch::fc0_out, Arch::fc1_out , Q> fc1{};
+  stack_affine<NT, Arch::fc2_in , Arch::fc2_out , Q> fc2{};
+  stack_affine<NT, Arch::fc3_in , 1             , Q> fc3{};
+
+  half_kp_weights<NT,Q,Arch>& load(weights_streamer<NT>& ws){
     quantizationInfo();
-    ///@todo read a version number first !
     w.load_(ws);
     b.load_(ws);
     fc0.load_(ws);
@@ -404,30 +567,78 @@ struct half_kp_weights{
     return *this;
   }
   
-  bool load(const std::string& path, half_kp_weights<NT,Q>& loadedWeights){
+  // scaling is set to the header one (0 if none)
+  bool load(const std::string& path, half_kp_weights<NT,Q,Arch>& loadedWeights, int & scaling){
+    auto ws = weights_streamer<NT>(path);
+    if ( !ws.ok() ){
+      Logging::LogIt(Logging::logError) << "File " << path << " is not accessible";
+      return false;
+    }
+    size_t fsize = 0;
 #ifndef __ANDROID__
 #ifndef WITHOUT_FILESYSTEM 
-    static const int expectedSize = 50378500;
     std::error_code ec;
-    auto fsize = std::filesystem::file_size(path,ec);
+    fsize = std::filesystem::file_size(path,ec);
     if ( ec ){
-      Logging::LogIt(Logging::logError) << "File " << path << " is not accessible";
-      return false;
-    }
-    if ( fsize != expectedSize ){
       Logging::LogIt(Logging::logError) << "File " << path << " does not look like a compatible net";
       return false;
     }
 #endif
 #endif
-    auto ws = weights_streamer<NT>(path);
-    loadedWeights = load(ws);
+    return load(ws, path, fsize, loadedWeights, scaling);
+  }
+
+  // from a memory buffer (an embedded net), input layer values are used in place when possible
+  bool load(const char * data, size_t size, const std::string & name, half_kp_weights<NT,Q,Arch>& loadedWeights, int & scaling){
+    auto ws = weights_streamer<NT>(data, size);
+    return load(ws, name, size, loadedWeights, scaling);
+  }
+
+private:
+  // size is not verified if 0
+  bool load(weights_streamer<NT>& ws, const std::string & name, size_t size, half_kp_weights<NT,Q,Arch>& loadedWeights, int & scaling){
+    net_header header;
+    ws.file.read(reinterpret_cast<char*>(&header), sizeof(net_header));
+    const bool withHeader = ws.file && header.magic == net_header::expectedMagic;
+    if ( withHeader ){
+      if ( header.version > net_header::currentVersion ){
+        Logging::LogIt(Logging::logError) << "Net " << name << " version " << header.version << " is not supported";
+        return false;
+      }
+      if ( !header.template matches<Arch>() ){
+        Logging::LogIt(Logging::logError) << "Net " << name << " architecture (" << header.archId << ", " << header.dims[0] << "x" << header.dims[1] << "x" << header.dims[2] << "x" << header.dims[3] 
+                                          << ") is not the one of this binary (" << Arch::id << ", " << Arch::dims[0] << "x" << Arch::dims[1] << "x" << Arch::dims[2] << "x" << Arch::dims[3] << ")";
+        return false;
+      }
+    }
+    else{
+      Logging::LogIt(Logging::logWarn) << "Net " << name << " has no header, only its size is verified";
+      ws.file.clear();
+      ws.file.seekg(0);
+    }
+    const size_t expectedSize = Arch::numel*sizeof(NT) + (withHeader ? sizeof(net_header) : 0);
+    if ( size && size != expectedSize ){
+      Logging::LogIt(Logging::logError) << "File " << name << " does not look like a compatible net";
+      return false;
+    }
+    load(ws);
+    if ( !ws.file ){
+      Logging::LogIt(Logging::logError) << "File " << name << " is truncated";
+      return false;
+    }
+    if ( withHeader && ws.checksum != header.checksum ){
+      Logging::LogIt(Logging::logError) << "Net " << name << " checksum mismatch";
+      return false;
+    }
+    scaling = withHeader ? header.scaling : 0;
+    loadedWeights = std::move(*this);
     return true;
   }
 };
 
-template<typename NT, bool Q>
+template<typename NT, bool Q, typename Arch = default_arch>
 struct feature_transformer{
+  static constexpr size_t base_dim = Arch::base_dim;
   const big_affine<NT, half_ka_numel, base_dim, Q>* weights_;
 
   typedef typename Quantization<Q>::BIT BIT;
@@ -502,22 +713,30 @@ struct sided{
   friend T;
 };
 
-template<typename NT, bool Q>
-struct half_kp_eval : sided<half_kp_eval<NT,Q>, feature_transformer<NT,Q>>{
-  static half_kp_weights<NT,Q> weights;
-  const half_kp_weights<NT,Q>* weights_;
-  feature_transformer<NT,Q> white;
-  feature_transformer<NT,Q> black;
+template<typename NT, bool Q, typename Arch = default_arch>
+struct half_kp_eval : sided<half_kp_eval<NT,Q,Arch>, feature_transformer<NT,Q,Arch>>{
+  static half_kp_weights<NT,Q,Arch> weights;
+  const half_kp_weights<NT,Q,Arch>* weights_;
+  feature_transformer<NT,Q,Arch> white;
+  feature_transformer<NT,Q,Arch> black;
 
   typedef typename Quantization<Q>::BT BT;
 
-  constexpr float propagate(Color c) const {
+  typedef Arch arch;
+
+  static constexpr size_t batch_size = 32;
+
+  constexpr stack_vector<BT, Arch::fc0_in> input(Color c) const {
     const auto w_x = white.active();
     const auto b_x = black.active();
-    const auto x0 = c == Co_White ? splice(w_x, b_x).apply_(clippedreluInput<BT,Q>) : splice(b_x, w_x).apply_(clippedreluInput<BT,Q>);
+    return c == Co_White ? splice(w_x, b_x).apply_(clippedreluInput<BT,Q>) : splice(b_x, w_x).apply_(clippedreluInput<BT,Q>);
+  }
+
+  constexpr float propagate(Color c) const {
+    const auto x0 = input(c);
     //std::cout << "x0 " << x0 << std::endl;
     //const stack_vector<BT, 32> x1 = stack_vector<BT, 32>::from((weights_ -> fc0).forward(x0).apply_(clippedreluQSingleLayer<QBT,true>).data,1.f/Quantization<true>::weightFactor);
-    const auto x1 = (weights_ -> fc0).forward(x0).apply_(clippedrelu<BT,Q>);
+    const auto x1 = (weights_ -> fc0).forward_sparse(x0).apply_(clippedrelu<BT,Q>);
     //std::cout << "x1 " << x1 << std::endl;
     const auto x2 = splice(x1, (weights_ -> fc1).forward(x1).apply_(clippedrelu<BT,Q>));
     //std::cout << "x2 " << x2 << std::endl;
@@ -528,6 +747,31 @@ struct half_kp_eval : sided<half_kp_eval<NT,Q>, feature_transformer<NT,Q>>{
     return val / Quantization<Q>::outFactor;
   }
 
+  // same as propagate for n evaluators (sides[k] is the point of view of evals[k]),
+  // inner layers are computed batch_size positions at a time so that weights are reused while in cache
+  static void propagate_batch(const half_kp_eval<NT,Q,Arch>* evals, const Color* sides, float* out, const size_t n){
+    stack_vector<BT, Arch::fc0_in>  x0[batch_size];
+    stack_vector<BT, Arch::fc0_out> x1[batch_size];
+    stack_vector<BT, Arch::fc1_out> y1[batch_size];
+    stack_vector<BT, Arch::fc2_in>  x2[batch_size];
+    stack_vector<BT, Arch::fc2_out> y2[batch_size];
+    stack_vector<BT, Arch::fc3_in>  x3[batch_size];
+    stack_vector<BT, 1>             y3[batch_size];
+    for(size_t k = 0; k < n; k += batch_size){
+      const size_t m = std::min(batch_size, n - k);
+      const half_kp_weights<NT,Q,Arch> & w = *evals[k].weights_;
+      for(size_t p = 0; p < m; ++p){ x0[p] = evals[k+p].input(sides[k+p]); }
+      w.fc0.forward_batch(x0, x1, m);
+      for(size_t p = 0; p < m; ++p){ x1[p].apply_(clippedrelu<BT,Q>); }
+      w.fc1.forward_batch(x1, y1, m);
+      for(size_t p = 0; p < m; ++p){ x2[p] = splice(x1[p], y1[p].apply_(clippedrelu<BT,Q>)); }
+      w.fc2.forward_batch(x2, y2, m);
+      for(size_t p = 0; p < m; ++p){ x3[p] = splice(x2[p], y2[p].apply_(clippedrelu<BT,Q>)); }
+      w.fc3.forward_batch(x3, y3, m);
+      for(size_t p = 0; p < m; ++p){ out[k+p] = y3[p].item() / Quantization<Q>::outFactor; }
+    }
+  }
+
 #ifdef DEBUG_NNUE_UPDATE
   bool operator==(const half_kp_eval<T> & other){
     return white == other.white && black == other.black;
@@ -542,8 +786,125 @@ struct half_kp_eval : sided<half_kp_eval<NT,Q>, feature_transformer<NT,Q>>{
   half_kp_eval() : weights_{&weights}, white{&(weights . w)}, black{&(weights . b)} {}
 };
 
-template<typename NT, bool Q>
-half_kp_weights<NT,Q> half_kp_eval<NT,Q>::weights;
+template<typename NT, bool Q, typename Arch>
+half_kp_weights<NT,Q,Arch> half_kp_eval<NT,Q,Arch>::weights;
+
+template<typename T> struct type_tag{ typedef T type; };
+
+// An evaluator for any of the compiled architectures. Only the architecture of the loaded net is active,
+// users dispatch once per operation (reset, update, propagate) to the concrete half_kp_eval.
+// Loading a net selects its architecture from the net header (or from the size of header less nets).
+template<typename NT, bool Q, typename... Archs>
+struct half_kp_eval_dispatch{
+  typedef std::variant<half_kp_eval<NT,Q,Archs>...> impl_type;
+  static constexpr size_t nbArch = sizeof...(Archs);
+  static constexpr size_t batch_size = 32;
+  static inline size_t active = 1; // index of the architecture of the loaded net (default_arch when none)
+
+  impl_type impl;
+
+  half_kp_eval_dispatch(){ select(); }
+
+  // use the active architecture (a net of another one may have been loaded since construction), accumulators are to be reset
+  void select(){ if ( impl.index() != active ) emplace_<0>(); }
+
+  template<typename F> decltype(auto) visit(F && f){ return std::visit(std::forward<F>(f), impl); }
+  template<typename F> decltype(auto) visit(F && f) const { return std::visit(std::forward<F>(f), impl); }
+
+  float propagate(Color c) const { return visit([c](const auto & e){ return e.propagate(c); }); }
+
+  // call f(type_tag<E>()) where E is the active half_kp_eval type
+  template<typename F> static void dispatch(F && f){ dispatch_<0>(f); }
+
+#ifdef DEBUG_NNUE_UPDATE
+  bool operator!=(half_kp_eval_dispatch & other){ return impl.index() != other.impl.index() || visit([&](auto & e){ return e != std::get<std::decay_t<decltype(e)>>(other.impl); }); }
+#endif
+
+  // scaling is set to the header one (0 if none), the active architecture only changes if the net is loaded
+  static bool load(const std::string & path, int & scaling){
+    net_header header;
+    std::ifstream is(path, std::ios::binary);
+    is.read(reinterpret_cast<char*>(&header), sizeof(net_header));
+    const bool withHeader = is && header.magic == net_header::expectedMagic;
+    is.clear();
+    is.seekg(0, std::ios::end);
+    const std::streamoff size = is.tellg();
+    if ( size <= 0 ){
+      Logging::LogIt(Logging::logError) << "File " << path << " is not accessible";
+      return false;
+    }
+    return load_(find_(header, withHeader, size_t(size)), path, [&](auto tag){
+      using E = typename decltype(tag)::type;
+      return half_kp_weights<NT,Q,typename E::arch>{}.load(path, E::weights, scaling);
+    });
+  }
+
+  static bool load(const char * data, size_t size, const std::string & name, int & scaling){
+    net_header header;
+    const bool withHeader = size >= sizeof(net_header) && (std::memcpy(&header, data, sizeof(net_header)), header.magic == net_header::expectedMagic);
+    return load_(find_(header, withHeader, size), name, [&](auto tag){
+      using E = typename decltype(tag)::type;
+      return half_kp_weights<NT,Q,typename E::arch>{}.load(data, size, name, E::weights, scaling);
+    });
+  }
+
+  // write a versioned header in front of a header less net of any compiled architecture
+  static bool add_header(const std::string & in, const std::string & out, int32_t scaling){
+    std::ifstream is(in, std::ios::binary | std::ios::ate);
+    const std::streamoff size = is.tellg();
+    const size_t idx = size > 0 ? find_(net_header{}, false, size_t(size)) : nbArch;
+    if ( idx >= nbArch ){
+      Logging::LogIt(Logging::logError) << "File " << in << " is not a header less net of a compiled architecture (" << archNames() << ")";
+      return false;
+    }
+    return with_(idx, [&](auto tag){ return nnue::add_header<NT, typename decltype(tag)::type::arch>(in, out, scaling); });
+  }
+
+  [[nodiscard]] static std::string archNames(){
+    std::string s;
+    ((s += (s.empty() ? "" : ", ") + std::to_string(Archs::base_dim) + "x" + std::to_string(Archs::fc0_out) + "x" + std::to_string(Archs::fc1_out) + "x" + std::to_string(Archs::fc2_out)), ...);
+    return s;
+  }
+
+private:
+  template<size_t I> void emplace_(){
+    if constexpr ( I < nbArch ){ if ( I == active ) impl.template emplace<I>(); else emplace_<I+1>(); }
+  }
+
+  template<size_t I, typename F> static void dispatch_(F & f){
+    if constexpr ( I < nbArch ){ if ( I == active ) f(type_tag<std::variant_alternative_t<I,impl_type>>{}); else dispatch_<I+1>(f); }
+  }
+
+  template<typename F, size_t I = 0> static bool with_(size_t idx, F && f){
+    if constexpr ( I < nbArch ){ return I == idx ? f(type_tag<std::variant_alternative_t<I,impl_type>>{}) : with_<F,I+1>(idx, std::forward<F>(f)); }
+    else return false;
+  }
+
+  // index of the compiled architecture of this net (from its header, or its size if none), nbArch if none
+  template<size_t I = 0> static size_t find_(const net_header & header, bool withHeader, size_t size){
+    if constexpr ( I < nbArch ){
+      typedef typename std::variant_alternative_t<I,impl_type>::arch A;
+      const bool found = withHeader ? header.template matches<A>() : size == A::numel*sizeof(NT);
+      return found ? I : find_<I+1>(header, withHeader, size);
+    }
+    else return nbArch;
+  }
+
+  template<typename F> static bool load_(size_t idx, const std::string & name, F && f){
+    if ( idx >= nbArch ){
+      Logging::LogIt(Logging::logError) << "Net " << name << " architecture is not one of this binary (" << archNames() << ")";
+      return false;
+    }
+    if ( !with_(idx, std::forward<F>(f)) ) return false;
+    active = idx;
+    with_(idx, [&](auto tag){
+      typedef typename decltype(tag)::type::arch A;
+      Logging::LogIt(Logging::logInfo) << "Net " << name << " uses architecture " << A::base_dim << "x" << A::fc0_out << "x" << A::fc1_out << "x" << A::fc2_out;
+      return true;
+    });
+    return true;
+  }
+};
 
 } // nnue
 
@@ -1,9 +1,11 @@
 #include "option.hpp"
 
+#include "book.hpp"
 #include "com.hpp"
 #include "logging.hpp"
 #include "searcher.hpp"
 #include "smp.hpp"
+#include "timers.hpp"
 
 #ifdef WITH_NNUE
 #include "nnue.hpp"
@@ -95,7 +97,15 @@ namespace Options {
        _keys.push_back(KeyBase(k_bool,  w_check, "UCI_LimitStrength"           , &DynamicConfig::limitStrength                  , false            , true ));
        _keys.push_back(KeyBase(k_int,   w_spin,  "UCI_Elo"                     , &DynamicConfig::strength                       , (int)500         , (int)2800 ));
        _keys.push_back(KeyBase(k_int,   w_spin,  "Hash"                        , &DynamicConfig::ttSizeMb                       , (unsigned int)1  , (unsigned int)256000                , &TT::initTable));
+       _keys.push_back(KeyBase(k_int,   w_spin,  "PawnHash"                    , &DynamicConfig::ttPawnSizeMb                   , (unsigned int)1  , (unsigned int)1024                  , std::bind(&ThreadPool::setup, &ThreadPool::instance())));
+#ifdef __linux__
+       _keys.push_back(KeyBase(k_string,w_string,"TTSharedMemory"              , &DynamicConfig::ttSharedMemory                                                                          , &TT::initTable));
+#endif
+       _keys.push_back(KeyBase(k_string,w_string,"TTFile"                      , &DynamicConfig::ttFile                                                                                  , &TT::loadFile));
+       _keys.push_back(KeyBase(k_bool,  w_check, "TTFileEveryGame"             , &DynamicConfig::ttFileEveryGame                , false            , true ));
+       _keys.push_back(KeyBase(k_int,   w_spin,  "TTSaveMinDepth"              , &DynamicConfig::ttSaveMinDepth                 , (int)0           , (int)MAX_DEPTH ));
        _keys.push_back(KeyBase(k_int,   w_spin,  "Threads"                     , &DynamicConfig::threads                        , (unsigned int)1  , (unsigned int)(MAX_THREADS-1)       , std::bind(&ThreadPool::setup, &ThreadPool::instance())));
+       _keys.push_back(KeyBase(k_bool,  w_check, "ABDADA"                      , &DynamicConfig::abdada                         , false            , true ));
        _keys.push_back(KeyBase(k_bool,  w_check, "UCI_Chess960"                , &DynamicConfig::FRC                            , false            , true ));
        _keys.push_back(KeyBase(k_bool,  w_check, "Ponder"                      , &DynamicConfig::UCIPonder                      , false            , true ));
        _keys.push_back(KeyBase(k_bool,  w_check, "MateFinder"                  , &DynamicConfig::mateFinder                     , false            , true ));
@@ -106,7 +116,15 @@ namespace Options {
        _keys.push_back(KeyBase(k_score, w_spin,  "ContemptMG"                  , &DynamicConfig::contemptMG                     , (ScoreType)-50   , (ScoreType)50));
 #ifdef WITH_SYZYGY
        _keys.push_back(KeyBase(k_string,w_string,"SyzygyPath"                  , &DynamicConfig::syzygyPath                                                                              , &SyzygyTb::initTB));
+       _keys.push_back(KeyBase(k_bool,  w_check, "SyzygyPrefetch"              , &DynamicConfig::syzygyPrefetch                 , false            , true                              , &SyzygyTb::initTB));
+#endif
+#ifdef WITH_TIMER
+       _keys.push_back(KeyBase(k_bool,  w_check, "Timers"                      , &DynamicConfig::timers                         , false            , true                              , &Timers::reset));
+       _keys.push_back(KeyBase(k_int,   w_spin,  "TimerSampling"               , &DynamicConfig::timerSampling                  , (unsigned int)1  , (unsigned int)1024                , &Timers::reset));
 #endif
+       _keys.push_back(KeyBase(k_string,w_string,"BookFile"                    , &DynamicConfig::bookFile                                                                                , &Book::init));
+       _keys.push_back(KeyBase(k_bool,  w_check, "BookBestMove"                , &DynamicConfig::bookBestMove                   , false            , true ));
+       _keys.push_back(KeyBase(k_string,w_string,"MaterialTableFile"           , &DynamicConfig::materialTableFile                                                                       , &MaterialHash::MaterialHashInitializer::init));
 #ifdef WITH_NNUE
        _keys.push_back(KeyBase(k_string,w_string,"NNUEFile"                    , &DynamicConfig::NNUEFile                                                                                , &NNUEWrapper::init));
        _keys.push_back(KeyBase(k_bool,  w_check, "forceNNUE"                   , &DynamicConfig::forceNNUE                      , false            , true                              ));
@@ -129,6 +147,8 @@ namespace Options {
 #ifdef WITH_SEARCH_TUNING
        _keys.push_back(KeyBase(k_score, w_spin, "qfutilityMargin0"                  , &SearchConfig::qfutilityMargin[0]                  , ScoreType(0)    , ScoreType(1500)     ));
        _keys.push_back(KeyBase(k_score, w_spin, "qfutilityMargin1"                  , &SearchConfig::qfutilityMargin[1]                  , ScoreType(0)    , ScoreType(1500)     ));
+       _keys.push_back(KeyBase(k_score, w_spin, "lazyEvalMargin0"                   , &SearchConfig::lazyEvalMargin[0]                   , ScoreType(0)    , ScoreType(1500)     ));
+       _keys.push_back(KeyBase(k_score, w_spin, "lazyEvalMargin1"                   , &SearchConfig::lazyEvalMargin[1]                   , ScoreType(0)    , ScoreType(1500)     ));
        _keys.push_back(KeyBase(k_depth, w_spin, "staticNullMoveMaxDepth0"           , &SearchConfig::staticNullMoveMaxDepth[0]           , DepthType(0)    , DepthType(30)       ));
        _keys.push_back(KeyBase(k_depth, w_spin, "staticNullMoveMaxDepth1"           , &SearchConfig::staticNullMoveMaxDepth[1]           , DepthType(0)    , DepthType(30)       ));
        _keys.push_back(KeyBase(k_score, w_spin, "staticNullMoveDepthCoeff0"         , &SearchConfig::staticNullMoveDepthCoeff[0]         , ScoreType(0)    , ScoreType(1500)     ));
@@ -210,8 +230,16 @@ namespace Options {
        GETOPT(debugMode,        bool)
        GETOPT(debugFile,        std::string)
        GETOPT(ttSizeMb,         unsigned int)
+       GETOPT(ttPawnSizeMb,     unsigned int)
+       GETOPT(ttFile,           std::string)
+       GETOPT(ttFileEveryGame,  bool)
+#ifdef __linux__
+       GETOPT(ttSharedMemory,   std::string)
+#endif
+       GETOPT(ttSaveMinDepth,   int)
        GETOPT(FRC,              bool)
        GETOPT(threads,          unsigned int)
+       GETOPT(abdada,           bool)
        GETOPT(mateFinder,       bool)
        GETOPT(fullXboardOutput, bool)
        GETOPT(level,            unsigned int)
@@ -220,8 +248,17 @@ namespace Options {
        GETOPT(limitStrength,    bool)
        GETOPT(strength,         int)
        GETOPT(moveOverHead,     unsigned int)
+       GETOPT(materialTableFile,std::string)
+       GETOPT(bookFile,         std::string)
+       GETOPT(bookBestMove,     bool)
+#ifdef WITH_TIMER
+       GETOPT(timers,           bool)
+       GETOPT(timerSampling,    unsigned int)
+       Timers::reset(); // as no option callback is called here
+#endif
 #ifdef WITH_SYZYGY
        GETOPT(syzygyPath,       std::string)
+       GETOPT(syzygyPrefetch,   bool)
 #endif
 #ifdef WITH_NNUE
        //GETOPT(useNNUE,          bool)         
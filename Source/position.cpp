@@ -2,15 +2,53 @@
 
 #include "bitboardTools.hpp"
 #include "dynamicConfig.hpp"
+#include "evalConfig.hpp"
 #include "hash.hpp"
 #include "logging.hpp"
 #include "material.hpp"
 #include "moveGen.hpp"
 
-template < typename T > T readFromString(const std::string & s){ std::stringstream ss(s); T tmp; ss >> tmp; return tmp;}
+namespace{
+   // FEN fields are only viewed inside the given string, no allocation and no stream here
+   struct FENFields{
+      std::array<std::string_view,6> f;
+      size_t n = 0;
+      [[nodiscard]] size_t size()const{ return n;}
+      [[nodiscard]] const std::string_view & operator[](size_t k)const{ return f[k];}
+   };
+
+   [[nodiscard]] FENFields splitFEN(const std::string & fen){
+      FENFields fields;
+      const std::string_view sv(fen);
+      size_t k = 0;
+      while( fields.n < fields.f.size() ){
+         while ( k < sv.size() && std::isspace((unsigned char)sv[k]) ) ++k;
+         if ( k >= sv.size() ) break;
+         const size_t b = k;
+         while ( k < sv.size() && !std::isspace((unsigned char)sv[k]) ) ++k;
+         fields.f[fields.n++] = sv.substr(b, k-b);
+      }
+      return fields;
+   }
+
+   [[nodiscard]] int readInt(const std::string_view & s){
+      int v = 0;
+      for (const char c : s){ if ( c < '0' || c > '9' ) break; v = 10*v + (c - '0'); }
+      return v;
+   }
+
+   [[nodiscard]] inline Piece charToPiece(char c){
+      switch (c) {
+      case 'p': return P_bp; case 'r': return P_br; case 'n': return P_bn; case 'b': return P_bb; case 'q': return P_bq; case 'k': return P_bk;
+      case 'P': return P_wp; case 'R': return P_wr; case 'N': return P_wn; case 'B': return P_wb; case 'Q': return P_wq; case 'K': return P_wk;
+      default: return P_none;
+      }
+   }
+}
 
-bool readFEN(const std::string & fen, Position & p, bool silent, bool withMoveCount){
-    static Position defaultPos;
+bool readFEN(const std::string & fen, Position & p, bool silent, bool withMoveCount, bool fatal){
+    static const Position defaultPos;
+    const Logging::LogLevel errorLevel = fatal ? Logging::logFatal : Logging::logError;
 #ifdef WITH_NNUE
     // backup evaluator
     NNUEEvaluator * evaluator = p.associatedEvaluator; 
@@ -20,55 +58,39 @@ bool readFEN(const std::string & fen, Position & p, bool silent, bool withMoveCo
     // restore initial evaluator ...
     if ( evaluator ) p.associateEvaluator(*evaluator); 
 #endif
-    std::vector<std::string> strList;
-    std::stringstream iss(fen);
-    std::copy(std::istream_iterator<std::string>(iss), std::istream_iterator<std::string>(), back_inserter(strList));
+    const FENFields strList = splitFEN(fen);
+    if ( strList.size() == 0 ) { Logging::LogIt(errorLevel) << "FEN ERROR -2 : empty fen string"; return false; }
 
     if ( !silent) Logging::LogIt(Logging::logInfo) << "Reading fen " << fen ;
 
-    // reset position
-    p.h = nullHash; p.ph = nullHash;
-    for(Square k = 0 ; k < NbSquare ; ++k) p.board(k) = P_none;
-
-    Square j = 1, i = 0;
-    while ((j <= NbSquare) && (i <= (char)strList[0].length())){
-        char letter = strList[0].at(i);
-        ++i;
-        const Square k = (7 - (j - 1) / 8) * 8 + ((j - 1) % 8);
-        switch (letter) {
-        case 'p': p.board(k) = P_bp; break;
-        case 'r': p.board(k) = P_br; break;
-        case 'n': p.board(k) = P_bn; break;
-        case 'b': p.board(k) = P_bb; break;
-        case 'q': p.board(k) = P_bq; break;
-        case 'k': p.board(k) = P_bk; p.king[Co_Black] = k; break;
-        case 'P': p.board(k) = P_wp; break;
-        case 'R': p.board(k) = P_wr; break;
-        case 'N': p.board(k) = P_wn; break;
-        case 'B': p.board(k) = P_wb; break;
-        case 'Q': p.board(k) = P_wq; break;
-        case 'K': p.board(k) = P_wk; p.king[Co_White] = k; break;
-        case '/': j--; break;
-        case '1': break;
-        case '2': j++; break;
-        case '3': j += 2; break;
-        case '4': j += 3; break;
-        case '5': j += 4; break;
-        case '6': j += 5; break;
-        case '7': j += 6; break;
-        case '8': j += 7; break;
-        default: Logging::LogIt(Logging::logFatal) << "FEN ERROR -1 : invalid character in fen string :" << letter << "\n" << fen;
-        }
-        j++;
+    // board, bitboards, board part of the hashes and PST score in one pass
+    // (defaultPos is empty : no piece, null hashes)
+    Square j = 0;
+    for (const char letter : strList[0]){
+        if ( j >= NbSquare ) break;
+        if ( letter == '/' ) continue;
+        if ( letter >= '1' && letter <= '8' ){ j += letter - '0'; continue; }
+        const Piece pp = charToPiece(letter);
+        if ( pp == P_none ) { Logging::LogIt(errorLevel) << "FEN ERROR -1 : invalid character in fen string :" << letter << "\n" << fen; return false; }
+        const Square k = (7 - j / 8) * 8 + (j % 8);
+        p.board(k) = pp;
+        BBTools::setBit(p, k, pp);
+        _setBit(p.allPieces[pp>0?Co_White:Co_Black], k);
+        p.h ^= Zobrist::ZT[k][pp+PieceShift];
+        if ( std::abs(pp) == P_wp || std::abs(pp) == P_wk ) p.ph ^= Zobrist::ZT[k][pp+PieceShift];
+        p.psq += EvalConfig::PSTValue(pp,k);
+        if ( pp == P_wk ) p.king[Co_White] = k;
+        else if ( pp == P_bk ) p.king[Co_Black] = k;
+        ++j;
     }
 
-    if ( p.king[Co_White] == INVALIDSQUARE || p.king[Co_Black] == INVALIDSQUARE ) { Logging::LogIt(Logging::logFatal) << "FEN ERROR 0 : missing king" ; return false; }
+    if ( p.king[Co_White] == INVALIDSQUARE || p.king[Co_Black] == INVALIDSQUARE ) { Logging::LogIt(errorLevel) << "FEN ERROR 0 : missing king" ; return false; }
 
     p.c = Co_White; // set the turn; default is white
     if (strList.size() >= 2){
         if (strList[1] == "w")      p.c = Co_White;
         else if (strList[1] == "b") p.c = Co_Black;
-        else { Logging::LogIt(Logging::logFatal) << "FEN ERROR 1 : bad Color" ; return false; }
+        else { Logging::LogIt(errorLevel) << "FEN ERROR 1 : bad Color" ; return false; }
     }
 
     // Initialize all castle possibilities (default is none)
@@ -119,21 +141,21 @@ bool readFEN(const std::string & fen, Position & p, bool silent, bool withMoveCo
     p.ep = INVALIDSQUARE;
     if ((strList.size() >= 4) && strList[3] != "-" ){
         if (strList[3].length() >= 2){
-            if ((strList[3].at(0) >= 'a') && (strList[3].at(0) <= 'h') && ((strList[3].at(1) == '3') || (strList[3].at(1) == '6'))) p.ep = stringToSquare(strList[3]);
-            else { Logging::LogIt(Logging::logFatal) << "FEN ERROR 2 : bad en passant square : " << strList[3] ; return false; }
+            if ((strList[3].at(0) >= 'a') && (strList[3].at(0) <= 'h') && ((strList[3].at(1) == '3') || (strList[3].at(1) == '6'))) p.ep = Square((strList[3][1] - '1') * 8 + (strList[3][0] - 'a'));
+            else { Logging::LogIt(errorLevel) << "FEN ERROR 2 : bad en passant square : " << strList[3] ; return false; }
         }
-        else{ Logging::LogIt(Logging::logFatal) << "FEN ERROR 3 : bad en passant square : " << strList[3] ; return false; }
+        else{ Logging::LogIt(errorLevel) << "FEN ERROR 3 : bad en passant square : " << strList[3] ; return false; }
     }
     else if ( !silent) Logging::LogIt(Logging::logInfo) << "No en passant square given" ;
 
     assert(p.ep == INVALIDSQUARE || (SQRANK(p.ep) == 2 || SQRANK(p.ep) == 5));
 
     // read 50 moves rules
-    if (withMoveCount && strList.size() >= 5) p.fifty = (unsigned char)readFromString<int>(strList[4]);
+    if (withMoveCount && strList.size() >= 5) p.fifty = (unsigned char)readInt(strList[4]);
     else p.fifty = 0;
 
     // read number of move
-    if (withMoveCount && strList.size() >= 6) p.moves = (unsigned char)readFromString<int>(strList[5]);
+    if (withMoveCount && strList.size() >= 6) p.moves = (unsigned char)readInt(strList[5]);
     else p.moves = 1;
 
     if (p.moves < 1) { // fix a LittleBlitzer bug here ...
@@ -145,10 +167,14 @@ bool readFEN(const std::string & fen, Position & p, bool silent, bool withMoveCo
 
     initCaslingPermHashTable(p);
 
-    BBTools::setBitBoards(p);
     MaterialHash::initMaterial(p);
-    p.h = computeHash(p);
-    p.ph = computePHash(p);
+    // complete the hash with game state (same as computeHash)
+    if ( p.ep != INVALIDSQUARE ) p.h ^= Zobrist::ZT[p.ep][NbPiece];
+    p.h ^= Zobrist::ZTCastling[p.castling];
+    p.h ^= Zobrist::ZT[p.c == Co_White ? 3 : 4][NbPiece];
+#ifdef DEBUG_HASH
+    (void)computeHash(p); // checks the hash against a full computation
+#endif
 
 #ifdef WITH_NNUE
     // If position is associated with an NNUE evaluator, 
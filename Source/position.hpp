@@ -2,6 +2,7 @@
 
 #include "definition.hpp"
 #include "bitboard.hpp"
+#include "score.hpp"
 
 #ifdef WITH_NNUE
 #include "nnue.hpp"
@@ -9,7 +10,7 @@
 
 struct Position; // forward decl
 
-bool readFEN(const std::string & fen, Position & p, bool silent = false, bool withMoveount = false); // forward decl
+bool readFEN(const std::string & fen, Position & p, bool silent = false, bool withMoveount = false, bool fatal = true); // forward decl, an invalid fen only returns false if !fatal
 
 /*!
  * The main position structure
@@ -18,6 +19,7 @@ bool readFEN(const std::string & fen, Position & p, bool silent = false, bool wi
  *  - all bitboards
  *  - material
  *  - hash (full position and just K+P)
+ *  - PST score (incrementally updated, white point of view)
  *  - some game status info
  *
  *  Contains also some usefull accessor
@@ -38,6 +40,7 @@ struct Position{
     Material mat = {{{{0}}}}; // such a nice syntax ...
 
     mutable Hash h = nullHash, ph = nullHash;
+    EvalScore psq;
     MiniMove lastMove = INVALIDMINIMOVE;
     unsigned short int moves = 0, halfmoves = 0;
     std::array<Square,2> king = { INVALIDSQUARE, INVALIDSQUARE };
@@ -83,8 +86,6 @@ struct Position{
 
 #ifdef WITH_NNUE
 
-  using NNUEEvaluator = nnue::half_kp_eval<NNUEWrapper::nnueNType,NNUEWrapper::quantization>;
-
   mutable NNUEEvaluator * associatedEvaluator = nullptr;
   void associateEvaluator(NNUEEvaluator & evaluator){ associatedEvaluator = &evaluator; }
 
@@ -102,8 +103,8 @@ struct Position{
     return feature_idx::major * HFlip(ksq) + HFlip(s) + feature_idx::them_offset(p);
   }
 
-  template<Color c>
-  void resetNNUEIndices_(NNUEEvaluator & nnueEvaluator)const {
+  template<Color c, typename E>
+  void resetNNUEIndices_(E & nnueEvaluator)const {
     using namespace feature_idx;
     //us
     BitBoard us_pawn     = pieces_const<P_wp>(c); while(us_pawn)     { nnueEvaluator.template us<c>().insert(NNUEIndiceUs  (king[c],popBit(us_pawn)    ,P_wp)); }
@@ -121,15 +122,28 @@ struct Position{
     BitBoard them_king   = pieces_const<P_wk>(~c); while(them_king)  { nnueEvaluator.template us<c>().insert(NNUEIndiceThem(king[c],popBit(them_king)  ,P_wk)); }
   }
 
-  void resetNNUEEvaluator(NNUEEvaluator & nnueEvaluator)const {
+  // for a concrete evaluator (E is the half_kp_eval of one architecture)
+  template<typename E>
+  void resetNNUEEvaluator_(E & nnueEvaluator)const {
     nnueEvaluator.white.clear();
     nnueEvaluator.black.clear();
     resetNNUEIndices_<Co_White>(nnueEvaluator);
     resetNNUEIndices_<Co_Black>(nnueEvaluator);
   }
 
+  // also switches the evaluator to the architecture of the loaded net
+  void resetNNUEEvaluator(NNUEEvaluator & nnueEvaluator)const {
+    nnueEvaluator.select();
+    nnueEvaluator.visit([this](auto & e){ resetNNUEEvaluator_(e); });
+  }
+
   template<Color c>
   void updateNNUEEvaluator(NNUEEvaluator & nnueEvaluator, const Move & m)const{
+    nnueEvaluator.visit([&](auto & e){ updateNNUEEvaluator_<c>(e, m); });
+  }
+
+  template<Color c, typename E>
+  void updateNNUEEvaluator_(E & nnueEvaluator, const Move & m)const{
     ///@todo to optimize, available in parent function !
     const Square from = Move2From(m);
     const Square to   = Move2To(m);
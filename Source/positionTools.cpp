@@ -1,6 +1,7 @@
 #include "positionTools.hpp"
 
 #include "dynamicConfig.hpp"
+#include "evalConfig.hpp"
 #include "logging.hpp"
 #include "moveGen.hpp"
 #include "pieceTools.hpp"
@@ -161,6 +162,16 @@ bool readMove(const Position & p, const std::string & ss, Square & from, Square
     return true;
 }
 
+EvalScore computePSQ(const Position & p){
+    EvalScore psq;
+    BitBoard b = p.occupancy();
+    while(b){
+        const Square k = popBit(b);
+        psq += EvalConfig::PSTValue(p.board_const(k),k);
+    }
+    return psq;
+}
+
 float gamePhase(const Position & p, ScoreType & matScoreW, ScoreType & matScoreB){
     const float totalMatScore = 2.f * *absValues[P_wq] + 4.f * *absValues[P_wr] + 4.f * *absValues[P_wb] + 4.f * *absValues[P_wn] + 16.f * *absValues[P_wp]; // cannot be static for tuning process ...
     const ScoreType matPieceScoreW = p.mat[Co_White][M_q] * *absValues[P_wq] + p.mat[Co_White][M_r] * *absValues[P_wr] + p.mat[Co_White][M_b] * *absValues[P_wb] + p.mat[Co_White][M_n] * *absValues[P_wn];
@@ -17,6 +17,8 @@
 
 bool readMove(const Position & p, const std::string & ss, Square & from, Square & to, MType & moveType );
 
+[[nodiscard]] EvalScore computePSQ(const Position & p);
+
 [[nodiscard]] float gamePhase(const Position & p, ScoreType & matScoreW, ScoreType & matScoreB);
 
 bool readEPDFile(const std::string & fileName, std::vector<std::string> & positions);
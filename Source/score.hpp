@@ -117,6 +117,13 @@ struct EvalData{
     float gp = 0;
     ScoreType danger[2] = {0,0};
     unsigned short int mobility[2] = {0,0};
+    bool lazy = false; // only cheap terms were computed (see eval lazyAlpha/lazyBeta)
+};
+
+// terms already summed by a lazy evaluation, so that it can be completed later without computing them again
+struct EvalPartial{
+    EvalFeatures features;
+    unsigned char tier = 0; // 0 : none, 1 : material and PST, 2 : and pawn structure
 };
 
 // used for easy move detection
@@ -10,6 +10,7 @@ ScoreType MvvLvaScores[6][6];
 
 // first value if eval score is used, second if hash score is used
 CONST_CLOP_TUNING ScoreType qfutilityMargin           [2] = {132, 132};
+CONST_CLOP_TUNING ScoreType lazyEvalMargin            [2] = {600, 400}; // tier 1 (material and PST), tier 2 (with pawn structure)
 CONST_CLOP_TUNING DepthType staticNullMoveMaxDepth    [2] = {6  , 6};
 CONST_CLOP_TUNING ScoreType staticNullMoveDepthCoeff  [2] = {80 , 80};
 CONST_CLOP_TUNING ScoreType staticNullMoveDepthInit   [2] = {0  , 0};
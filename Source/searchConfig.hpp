@@ -25,6 +25,7 @@ const bool doCMHPruning     = true;
 
 // first value if eval score is used, second if hash score is used
 extern CONST_CLOP_TUNING ScoreType qfutilityMargin           [2];
+extern CONST_CLOP_TUNING ScoreType lazyEvalMargin            [2];
 extern CONST_CLOP_TUNING DepthType staticNullMoveMaxDepth    [2];
 extern CONST_CLOP_TUNING ScoreType staticNullMoveDepthCoeff  [2];
 extern CONST_CLOP_TUNING ScoreType staticNullMoveDepthInit   [2];
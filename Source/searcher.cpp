@@ -2,13 +2,17 @@
 
 #include "logging.hpp"
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 TimeType Searcher::getCurrentMoveMs() {
-    if (TimeMan::isUCIPondering || TimeMan::isUCIAnalysis) {
+    if (TimeMan::isUCIPondering.load(std::memory_order_relaxed) || TimeMan::isUCIAnalysis.load(std::memory_order_relaxed)) {
         return INFINITETIME;
     }
-    TimeType ret = currentMoveMs;
+    TimeType ret = currentMoveMs.load(std::memory_order_relaxed);
     if (TimeMan::msecUntilNextTC > 0){
-        switch (moveDifficulty) {
+        switch (moveDifficulty.load(std::memory_order_relaxed)) {
         case MoveDifficultyUtil::MD_forced:      ret = (ret >> 4); break; // only one move in movelist !
         case MoveDifficultyUtil::MD_easy:        ret = (ret >> 3); break; // a short depth open search shows one move is far behind others
         case MoveDifficultyUtil::MD_std:         break; // nothing special
@@ -27,17 +31,12 @@ void Searcher::getCMHPtr(const unsigned int ply, CMHPtrArray & cmhPtr){
         assert(ply-k < MAX_PLY && int(ply)-int(k) >= 0);
         if( ply > k && VALIDMOVE(stack[ply-k].p.lastMove)){
            const Square to = Move2To(stack[ply-k].p.lastMove);
-           cmhPtr[k] = historyT.counter_history[stack[ply-k-1].p.board_const(to)+PieceShift][to];
+           const Piece pp = stack[ply-k].p.board_const(to); // the piece that moved (empty for castling)
+           if ( pp != P_none ) cmhPtr[k] = historyT.counter_history[CMHPieceIdx(pp)][to];
         }
     }
 }
 
-ScoreType Searcher::getCMHScore(const Position & p, const Square from, const Square to, const CMHPtrArray & cmhPtr) const {
-    ScoreType ret = 0;
-    for (int i = 0; i < MAX_CMH_PLY; i ++){ if (cmhPtr[i]){ ret += cmhPtr[i][(p.board_const(from)+PieceShift) * NbSquare + to]; } }
-    return ret;
-}
-
 ScoreType Searcher::drawScore() { return -1 + 2*((stats.counters[Stats::sid_nodes]+stats.counters[Stats::sid_qnodes]) % 2); }
 
 void Searcher::idleLoop(){
@@ -109,33 +108,44 @@ bool Searcher::searching()const{
 
 void Searcher::initPawnTable(){
     assert(tablePawn==0);
+    ttSizePawn = powerFloor((1024ull * 1024ull * std::max(1u,DynamicConfig::ttPawnSizeMb)) / (unsigned long long int)sizeof(PawnEntry));
     assert(ttSizePawn>0);
     Logging::LogIt(Logging::logInfo) << "Init Pawn TT : " << ttSizePawn;
     Logging::LogIt(Logging::logInfo) << "PawnEntry size " << sizeof(PawnEntry);
-    tablePawn.reset(new PawnEntry[ttSizePawn]);
+    const size_t bytes = ttSizePawn*sizeof(PawnEntry);
+    tablePawn.reset((PawnEntry *) std_aligned_alloc(std::min(bytes,size_t(2*1024*1024)),bytes)); // huge page aligned when possible
+#ifdef __linux__
+    madvise(tablePawn.get(), bytes, MADV_HUGEPAGE); // only a hint, may be ignored
+#endif
     Logging::LogIt(Logging::logInfo) << "Size of Pawn TT " << ttSizePawn * sizeof(PawnEntry) / 1024 << "Kb" ;
+    // not filled here : the thread using it shall do it first (clearGame or newGamePending) so that pages are local to it
 }
 
 void Searcher::clearPawnTT() {
-    for (unsigned int k = 0; k < ttSizePawn; ++k) tablePawn[k].h = nullHash;
+    std::fill(&tablePawn[0], &tablePawn[0] + ttSizePawn, PawnEntry());
 }
 
 void Searcher::clearGame(){
-     clearPawnTT();
+     stats.init();
+     clearSearchTables(true);
+}
+
+void Searcher::clearSearch(bool forceCounterClear){
      stats.init();
      killerT.initKillers();
-     historyT.initHistory();
+     historyT.initHistory(!forceCounterClear);
      counterT.initCounter();
      previousBest = INVALIDMOVE;
 }
 
-void Searcher::clearSearch(bool forceCounterClear){
+void Searcher::clearSearchTables(bool newGame){
      //clearPawnTT(); // to be used for reproductible results ///@todo verify again
-     stats.init();
+     if ( newGame ) clearPawnTT();
      killerT.initKillers();
-     historyT.initHistory(!forceCounterClear);
+     historyT.initHistory(!newGame);
      counterT.initCounter();
      previousBest = INVALIDMOVE;
+     newGamePending = false;
 }
 
 bool Searcher::getPawnEntry(Hash h, PawnEntry *& pe){
@@ -159,7 +169,6 @@ void Searcher::prefetchPawn(Hash h) {
 }
 
 std::atomic<bool> Searcher::startLock;
-const unsigned long long int Searcher::ttSizePawn = 1024*32;
 
 #ifdef WITH_GENFILE
 void Searcher::writeToGenFile(const Position & p){
@@ -170,6 +179,7 @@ void Searcher::writeToGenFile(const Position & p){
     if ( coSearchers.find(id()) == coSearchers.end()){
         coSearchers[id()] = std::unique_ptr<Searcher>(new Searcher(id()+MAX_THREADS));
         coSearchers[id()]->initPawnTable();
+        coSearchers[id()]->clearGame(); // from the owning thread
     }
 
     Searcher & cos = *coSearchers[id()];
@@ -17,9 +17,11 @@
  * Many things are templates here, so other hpp file are included at the bottom of this one.
  */
 struct Searcher{
-    bool stopFlag = true;
-    MoveDifficultyUtil::MoveDifficulty moveDifficulty = MoveDifficultyUtil::MD_std;
-    TimeType currentMoveMs = 777;
+    std::atomic<bool> stopFlag {true};
+    Counter periodicCheck = 0; // nodes before next nodes limit verification (main thread only)
+    // written by the search, read by the time watchdog thread (relaxed atomics, only the latest value matters)
+    std::atomic<MoveDifficultyUtil::MoveDifficulty> moveDifficulty {MoveDifficultyUtil::MD_std};
+    std::atomic<TimeType> currentMoveMs {777};
     
     TimeType getCurrentMoveMs(); // use this (and not the variable) to take emergency time into account !
 
@@ -42,6 +44,10 @@ struct Searcher{
 
     std::vector<RootScores> rootScores;
 
+#ifdef WITH_SYZYGY
+    MoveList tbRootMoves; // filled once at search start if root position is inside TB
+#endif
+
     // used for move ordering
     Move previousBest = INVALIDMOVE;
 
@@ -59,7 +65,6 @@ struct Searcher{
 #endif
 
     void getCMHPtr(const unsigned int ply, CMHPtrArray & cmhPtr);
-    [[nodiscard]] ScoreType getCMHScore(const Position & p, const Square from, const Square to, const CMHPtrArray & cmhPtr)const;
 
     [[nodiscard]] ScoreType drawScore();
 
@@ -134,13 +139,11 @@ struct Searcher{
   
     [[nodiscard]] bool searching()const;
 
-    #pragma pack(push, 1)
-    struct PawnEntry{
-        BitBoard pawnTargets[2]   = {emptyBitBoard,emptyBitBoard};
+    // one entry per cache line (pawn attacks and open files are recomputed at each eval)
+    struct alignas(64) PawnEntry{
         BitBoard holes[2]         = {emptyBitBoard,emptyBitBoard};
         BitBoard semiOpenFiles[2] = {emptyBitBoard,emptyBitBoard};
         BitBoard passed[2]        = {emptyBitBoard,emptyBitBoard};
-        BitBoard openFiles        = emptyBitBoard;
         EvalScore score           = {0,0};
         ScoreType danger[2]       = {0,0};
         MiniHash h                = nullHash;
@@ -150,10 +153,12 @@ struct Searcher{
             danger[Co_Black] = 0;
         }
     };
-    #pragma pack(pop)
+    static_assert(sizeof(PawnEntry) == 64, "PawnEntry shall fit a cache line");
+
+    struct DeletePawnTable{ void operator()(PawnEntry * ptr) const { std_aligned_free(ptr); } };
 
-    static const unsigned long long int ttSizePawn;
-    std::unique_ptr<PawnEntry[]> tablePawn = 0;
+    unsigned long long int ttSizePawn = 0; // from DynamicConfig::ttPawnSizeMb, per thread
+    std::unique_ptr<PawnEntry[],DeletePawnTable> tablePawn = nullptr;
 
     void initPawnTable();
 
@@ -161,6 +166,10 @@ struct Searcher{
 
     void clearGame();
     void clearSearch(bool forceCounterClear = false);
+    // killers, history and counters (counter history and pawn table only for a new game)
+    void clearSearchTables(bool newGame);
+    // set by ThreadPool::clearGame, the thread will itself reset new game tables at next search start
+    bool newGamePending = false;
 
     [[nodiscard]] bool getPawnEntry(Hash h, PawnEntry *& pe);
 
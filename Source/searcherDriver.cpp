@@ -59,6 +59,9 @@ PVList Searcher::search(const Position & pp, Move & m, DepthType & d, ScoreType
     stopFlag = false;
     moveDifficulty = MoveDifficultyUtil::MD_std;
     startTime = Clock::now();
+    periodicCheck = 0;
+    // main thread time is verified by a watchdog thread during the whole search
+    std::unique_ptr<TimeMan::Watchdog> watchdog(isMainThread() && !subSearch ? new TimeMan::Watchdog(*this) : nullptr);
 
 #ifdef WITH_GENFILE
     // open the genfen file for output if needed
@@ -67,6 +70,9 @@ PVList Searcher::search(const Position & pp, Move & m, DepthType & d, ScoreType
     }
 #endif
 
+    // each thread resets its own tables (so this is done in parallel)
+    if ( !subSearch ) clearSearchTables(newGamePending);
+
     // Main thread only will reset some table
     if ( isMainThread() || id() >= MAX_THREADS ){
         Logging::LogIt(Logging::logInfo) << "Search params :" ;
@@ -75,7 +81,7 @@ PVList Searcher::search(const Position & pp, Move & m, DepthType & d, ScoreType
         if ( isMainThread()){
            TT::age();
            MoveDifficultyUtil::variability = 1.f; // not usefull for co-searcher threads that won't depend on time
-           ThreadPool::instance().clearSearch();  // reset data for all other threads !!!
+           ThreadPool::instance().clearSearch();  // reset stats for all other threads !!!
         }
     }
     // other threads will wait here for start signal
@@ -93,6 +99,20 @@ PVList Searcher::search(const Position & pp, Move & m, DepthType & d, ScoreType
         stack[p.halfmoves] = {p,computeHash(p),data,e,INVALIDMINIMOVE};
     }
 
+#ifdef WITH_SYZYGY
+    // root TB probe is done once here (and not in every root pvs call), pvs will only search those moves
+    tbRootMoves.clear();
+    if ( isMainThread() ) SyzygyTb::prefetch(p);
+    if ( countBit(p.occupancy()) <= SyzygyTb::MAX_TB_MEN ){
+        ScoreType tbScore = 0;
+        if ( SyzygyTb::probe_root(*this, p, tbScore, tbRootMoves) < 0 ) tbRootMoves.clear(); // only good moves if TB success
+        else{
+            ++stats.counters[Stats::sid_tbHit2];
+            moveDifficulty = tbRootMoves.size() == 1 ? MoveDifficultyUtil::MD_forced : MoveDifficultyUtil::MD_easy;
+        }
+    }
+#endif
+
     // initialize search results
     DepthType reachedDepth = 0;
     PVList pvOut;
@@ -145,6 +165,8 @@ PVList Searcher::search(const Position & pp, Move & m, DepthType & d, ScoreType
     // using MAX_DEPTH-6 so that draw can be found for sure ///@todo I don't understand this -6 anymore ..
     for(DepthType depth = startDepth ; depth <= std::min(d,DepthType(MAX_DEPTH-6)) && !stopFlag ; ++depth ){ 
         
+        const Counter depthStartNodes = stats.counters[Stats::sid_nodes] + stats.counters[Stats::sid_qnodes];
+
         // MultiPV loop
         std::vector<MiniMove> skipMoves;
         for (unsigned int multi = 0 ; multi < DynamicConfig::multiPV && !stopFlag ; ++multi){
@@ -290,9 +312,9 @@ PVList Searcher::search(const Position & pp, Move & m, DepthType & d, ScoreType
 
                     // update a "variability" measure to scale remaining time on it ///@todo tune this more
                     if ( depth > 12 && pvLoc.size() ){
-                        if ( getData().datas.moves[depth] != getData().datas.moves[depth-1] ) MoveDifficultyUtil::variability *= (1.f + float(depth)/100);
-                        else MoveDifficultyUtil::variability *= 0.97f;
-                        Logging::LogIt(Logging::logInfo) << "Variability :" << MoveDifficultyUtil::variability;
+                        if ( getData().datas.moves[depth] != getData().datas.moves[depth-1] ) MoveDifficultyUtil::variability = MoveDifficultyUtil::variability * (1.f + float(depth)/100);
+                        else MoveDifficultyUtil::variability = MoveDifficultyUtil::variability * 0.97f;
+                        Logging::LogIt(Logging::logInfo) << "Variability :" << MoveDifficultyUtil::variability.load();
                         Logging::LogIt(Logging::logInfo) << "Variability time factor :" << MoveDifficultyUtil::variabilityFactor();
                     }
 
@@ -312,6 +334,10 @@ PVList Searcher::search(const Position & pp, Move & m, DepthType & d, ScoreType
             }
         } // multiPV loop end
 
+        // per depth effort (nothing is counted when a helper thread skips this depth)
+        stats.depthNodes[depth] += stats.counters[Stats::sid_nodes] + stats.counters[Stats::sid_qnodes] - depthStartNodes;
+        if ( reachedDepth == depth ) ++stats.depthCompleted[depth];
+
     } // iterative deepening loop end
 
 pvsout:
@@ -29,21 +29,16 @@ ScoreType Searcher::pvs(ScoreType alpha,
                         bool canPrune, 
                         const std::vector<MiniMove>* skipMoves){
     if (stopFlag) return STOPSCORE;
-    if ( isMainThread() ){
-        static int periodicCheck = 0;
+    // time is verified by the watchdog thread (see TimeMan::Watchdog), only nodes limit is checked here
+    if ( isMainThread() && TimeMan::maxNodes > 0 ){
         if ( periodicCheck == 0 ){
-            periodicCheck = (TimeMan::maxNodes > 0) ? std::min(TimeMan::maxNodes/PERIODICCHECK,PERIODICCHECK) : PERIODICCHECK;
+            periodicCheck = std::max(1ull,std::min(TimeMan::maxNodes/PERIODICCHECK,PERIODICCHECK));
             const Counter nodeCount = ThreadPool::instance().counter(Stats::sid_nodes) + ThreadPool::instance().counter(Stats::sid_qnodes);
-            if ( TimeMan::maxNodes > 0 && nodeCount > TimeMan::maxNodes) { 
+            if ( nodeCount > TimeMan::maxNodes) { 
                 stopFlag = true; 
                 Logging::LogIt(Logging::logInfo) << "stopFlag triggered (nodes limits) in thread " << id(); 
                 return STOPSCORE;
             } 
-            if ( (TimeType)std::max(1, (int)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startTime).count()) > getCurrentMoveMs() ){ 
-                stopFlag = true; 
-                Logging::LogIt(Logging::logInfo) << "stopFlag triggered in thread " << id(); 
-                return STOPSCORE;
-            }
         }
         --periodicCheck;
     }
@@ -130,7 +125,7 @@ ScoreType Searcher::pvs(ScoreType alpha,
             if ( matHash != nullHash ){
                ++stats.counters[Stats::sid_materialTableHits];
                const MaterialHash::MaterialHashEntry & MEntry = MaterialHash::materialHashTable[matHash];
-               data.gp = MEntry.gp;
+               data.gp = MEntry.gp();
             }
             else{ // if no match, compute game phase (this does not happend very often ...)
                ScoreType matScoreW = 0;
@@ -310,6 +305,12 @@ ScoreType Searcher::pvs(ScoreType alpha,
 
     bool bestMoveIsCheck = false;
 
+#ifdef WITH_SYZYGY
+    // at root, TT move must be a TB optimal one
+    if ( rootnode && validTTmove && !tbRootMoves.empty() 
+         && std::find_if(tbRootMoves.begin(), tbRootMoves.end(), [&](const Move & m){ return sameMove(e.m,m);}) == tbRootMoves.end() ) validTTmove = false;
+#endif
+
     // try the tt move before move generation (if not skipped move)
     if ( validTTmove && !isSkipMove(e.m,skipMoves)) { // should be the case thanks to iid at pvnode
         bestMove = e.m; // in order to preserve tt move for alpha bound entry
@@ -355,7 +356,7 @@ ScoreType Searcher::pvs(ScoreType alpha,
                /*
                // CMH extension
                if (EXTENDMORE(extension) && isQuiet) {
-                   const int pp = (p.board_const(Move2From(e.m)) + PieceShift) * NbSquare + to;
+                   const int pp = CMHIdx(p.board_const(Move2From(e.m)),to);
                    if (cmhPtr[0] && cmhPtr[1] && cmhPtr[0][pp] >= HISTORY_MAX / 2 && cmhPtr[1][pp] >= HISTORY_MAX / 2) ++stats.counters[Stats::sid_CMHExtension], ++extension;
                }
                */
@@ -424,13 +425,9 @@ ScoreType Searcher::pvs(ScoreType alpha,
     }
 
 #ifdef WITH_SYZYGY
-    if (rootnode && withoutSkipMove && (countBit(p.allPieces[Co_White] | p.allPieces[Co_Black])) <= SyzygyTb::MAX_TB_MEN) {
-        tbScore = 0;
-        if (SyzygyTb::probe_root(*this, p, tbScore, moves) < 0) { // only good moves if TB success
-            if (capMoveGenerated) MoveGen::generate<MoveGen::GP_quiet>(p, moves, true);
-            else                  MoveGen::generate<MoveGen::GP_all>  (p, moves, false);
-        }
-        else ++stats.counters[Stats::sid_tbHit2];
+    // root TB moves are probed once in search driver
+    if (rootnode && withoutSkipMove && !tbRootMoves.empty()) {
+        moves = tbRootMoves;
         moveGenerated = true;
     }
 #endif
@@ -443,17 +440,35 @@ ScoreType Searcher::pvs(ScoreType alpha,
     }
     if (moves.empty()) return isInCheck ? -MATE + ply : 0;
 
+    // ABDADA : helper threads defer moves currently searched by another thread at same depth (needs partial sort loop)
+#ifdef USE_PARTIAL_SORT
+    const bool abdadaNode = DynamicConfig::abdada && DynamicConfig::threads > 1 && !subSearch && id() < MAX_THREADS && depth >= ABDADA::minDepth;
+    Move deferredMoves[MAX_MOVE]; // only used if abdadaNode (a plain array so that no allocation is done at each node)
+    size_t deferredCount = 0, deferredOffset = 0;
+#else
+    const bool abdadaNode = false;
+#endif
+
 #ifdef USE_PARTIAL_SORT
     MoveSorter::score(*this, moves, p, data.gp, ply, cmhPtr, true, isInCheck, validTTmove?&e:NULL, refutation != INVALIDMINIMOVE && isCapture(Move2Type(refutation)) ? refutation : INVALIDMINIMOVE);
     size_t offset = 0;
     const Move * it = nullptr;
-    while( (it = MoveSorter::pickNext(moves,offset)) && !stopFlag){
+    while( ((it = MoveSorter::pickNext(moves,offset)) || (deferredOffset < deferredCount && (it = &deferredMoves[deferredOffset++]))) && !stopFlag){
 #else
     MoveSorter::scoreAndSort(*this, moves, p, data.gp, ply, cmhPtr, true, isInCheck, validTTmove?&e:NULL, refutation != INVALIDMINIMOVE && isCapture(Move2Type(refutation)) ? refutation : INVALIDMINIMOVE);
     for(auto it = moves.begin() ; it != moves.end() && !stopFlag ; ++it){
 #endif
         if (isSkipMove(*it,skipMoves)) continue; // skipmoves
         if (validTTmove && sameMove(e.m, *it)) continue; // already tried
+        const Hash abdadaKey = abdadaNode ? ABDADA::key(pHash,*it,depth) : nullHash;
+#ifdef USE_PARTIAL_SORT
+        // never defer the first move, and deferred moves are searched only once all others are done
+        if ( abdadaNode && !isMainThread() && validMoveCount > 0 && deferredOffset == 0 && ABDADA::isSearching(abdadaKey) ){
+            deferredMoves[deferredCount++] = *it;
+            ++stats.counters[Stats::sid_abdadaDefer];
+            continue;
+        }
+#endif
         Position p2 = p;
 #ifdef WITH_NNUE
         NNUEEvaluator newEvaluator = p.Evaluator();
@@ -491,7 +506,7 @@ ScoreType Searcher::pvs(ScoreType alpha,
            // CMH extension
            /*
            if (EXTENDMORE(extension) && isQuiet) {
-               const int pp = (p.board_const(Move2From(*it)) + PieceShift) * NbSquare + to;
+               const int pp = CMHIdx(p.board_const(Move2From(*it)),to);
                if (cmhPtr[0] && cmhPtr[1] && cmhPtr[0][pp] >= HISTORY_MAX/2 && cmhPtr[1][pp] >= HISTORY_MAX/2) ++stats.counters[Stats::sid_CMHExtension], ++extension;
            }
            */
@@ -520,6 +535,7 @@ ScoreType Searcher::pvs(ScoreType alpha,
            }
            */
         }
+        const ABDADA::Guard abdadaGuard(abdadaKey,abdadaNode); // tell other threads this move is being searched
         // pvs
         if (validMoveCount < (2/*+2*rootnode*/) || !SearchConfig::doPVS ) 
            score = -pvs<pvnode>(-beta, -alpha, p2, depth-1+extension, ply+1, childPV, seldepth, isCheck, !cutNode, true);
@@ -553,7 +569,7 @@ ScoreType Searcher::pvs(ScoreType alpha,
             if (historyPruning && isPrunableStdNoCheck && Move2Score(*it) < SearchConfig::historyPruningThresholdInit + marginDepth*SearchConfig::historyPruningThresholdDepth) {++stats.counters[Stats::sid_historyPruning]; continue;}
             // CMH pruning alone
             if (CMHPruning && isPrunableStdNoCheck){
-              const int pp = (p.board_const(Move2From(*it))+PieceShift) * NbSquare + Move2To(*it);
+              const int pp = CMHIdx(p.board_const(Move2From(*it)),Move2To(*it));
               if ((!cmhPtr[0] || cmhPtr[0][pp] < 0) && (!cmhPtr[1] || cmhPtr[1][pp] < 0)) { ++stats.counters[Stats::sid_CMHPruning]; continue;}
             }
             // SEE (capture)
@@ -619,9 +635,22 @@ ScoreType Searcher::pvs(ScoreType alpha,
                         // increase history bonus of this move
                         updateTables(*this, p, depth + (score>beta + SearchConfig::betaMarginDynamicHistory), ply, *it, TT::B_beta, cmhPtr);
                         // reduce history bonus of all previous
+                        const DepthType malusDepth = depth + (score > (beta + SearchConfig::betaMarginDynamicHistory));
+#ifdef USE_PARTIAL_SORT
+                        // follow the order moves were searched in : picked ones but the deferred, then the deferred ones
+                        for(size_t k = 0 ; k < offset ; ++k){
+                            if ( std::find(deferredMoves, deferredMoves+deferredCount, moves[k]) != deferredMoves+deferredCount ) continue; // searched later
+                            if ( sameMove(moves[k],*it) ) break;
+                            if ( Move2Type(moves[k]) == T_std ) historyT.update<-1>(malusDepth, moves[k], p, cmhPtr);
+                        }
+                        for(size_t k = 0 ; k+1 < deferredOffset ; ++k){
+                            if ( Move2Type(deferredMoves[k]) == T_std ) historyT.update<-1>(malusDepth, deferredMoves[k], p, cmhPtr);
+                        }
+#else
                         for(auto it2 = moves.begin() ; it2 != moves.end() && !sameMove(*it2,*it); ++it2) {
-                            if ( Move2Type(*it2) == T_std ) historyT.update<-1>(depth + (score > (beta + SearchConfig::betaMarginDynamicHistory)), *it2, p, cmhPtr);
+                            if ( Move2Type(*it2) == T_std ) historyT.update<-1>(malusDepth, *it2, p, cmhPtr);
                         }
+#endif
                     }
                     hashBound = TT::B_beta;
                     break;
@@ -59,7 +59,7 @@ ScoreType Searcher::qsearch(ScoreType alpha,
                             bool qRoot, 
                             bool pvnode, 
                             signed char isInCheckHint){
-    if (stopFlag) return STOPSCORE; // no time verification in qsearch, too slow
+    if (stopFlag) return STOPSCORE; // set by the watchdog thread when time is over
     ++stats.counters[Stats::sid_qnodes];
 
     alpha = std::max(alpha, (ScoreType)(-MATE + ply));
@@ -100,6 +100,7 @@ ScoreType Searcher::qsearch(ScoreType alpha,
 
     // get a static score for the position.
     ScoreType evalScore;
+    EvalPartial evalPartial;
     if (isInCheck) evalScore = -MATE + ply;
     else if ( p.lastMove == NULLMOVE && ply > 0 ) evalScore = 2*ScaleScore(EvalConfig::tempo,stack[p.halfmoves-1].data.gp) - stack[p.halfmoves-1].eval; // skip eval if nullmove just applied ///@todo wrong ! gp is 0 here so tempoMG must be == tempoEG
     else{
@@ -111,7 +112,7 @@ ScoreType Searcher::qsearch(ScoreType alpha,
             if ( matHash != nullHash){
                ++stats.counters[Stats::sid_materialTableHits];
                const MaterialHash::MaterialHashEntry & MEntry = MaterialHash::materialHashTable[matHash];
-               data.gp = MEntry.gp;
+               data.gp = MEntry.gp();
             }
             else{
                ScoreType matScoreW = 0;
@@ -124,15 +125,15 @@ ScoreType Searcher::qsearch(ScoreType alpha,
         }
         else {
             ++stats.counters[Stats::sid_ttscmiss];
-            evalScore = eval(p, data, *this);
+            evalScore = eval(p, data, *this, true, false, nullptr, alpha, beta, &evalPartial); // stand-pat only needs to be compared to the window
         }
     }
-    const ScoreType staticScore = evalScore;
+    ScoreType staticScore = evalScore;
     bool evalScoreIsHashScore = false;
     // use tt score if possible and not in check
     if ( !isInCheck){
        if ( ttHit && ((bound == TT::B_alpha && e.s <= evalScore) || (bound == TT::B_beta && e.s >= evalScore) || (bound == TT::B_exact)) ) evalScore = e.s, evalScoreIsHashScore = true;
-       if ( !ttHit ) TT::setEntry(*this,pHash,INVALIDMOVE,createHashScore(evalScore,ply),createHashScore(evalScore,ply),TT::B_none,-2); // already insert an eval here in case of pruning ...
+       if ( !ttHit && !data.lazy ) TT::setEntry(*this,pHash,INVALIDMOVE,createHashScore(evalScore,ply),createHashScore(evalScore,ply),TT::B_none,-2); // already insert an eval here in case of pruning ...
     }
 
     // early cut-off based on eval score (static or from TT score)
@@ -141,6 +142,9 @@ ScoreType Searcher::qsearch(ScoreType alpha,
         return evalScore;
     }
     if ( !isInCheck && SearchConfig::doQDeltaPruning && staticScore + qDeltaMargin(p) < alpha ) return ++stats.counters[Stats::sid_delta],alpha;
+    // a lazy (low side) stand-pat is only an approximation, the full one is needed from now on as it is stored in TT and used as static eval by pvs
+    // it is completed from the terms already summed
+    if ( data.lazy ) staticScore = evalScore = eval(p, data, *this, true, false, nullptr, -MATE, MATE, &evalPartial);
     if ( evalScore > alpha) alpha = evalScore;
 
     TT::Bound b = TT::B_alpha;
@@ -5,7 +5,7 @@
 ScoreType Searcher::SEE(const Position & p, const Move & m) const {
     if ( ! VALIDMOVE(m) ) return 0;
 
-    START_TIMER
+    START_TIMER(See)
 
     Square from = Move2From(m); assert(squareOK(from));
     const Square to = Move2To(m); assert(squareOK(to));
@@ -85,7 +85,7 @@ bool Searcher::SEE_GE(const Position & p, const Move & m, ScoreType threshold) c
 // Static Exchange Evaluation (cutoff version algorithm from Stockfish)
 bool Searcher::SEE_GE(const Position & p, const Move & m, ScoreType threshold) const{
     assert(VALIDMOVE(m));
-    START_TIMER
+    START_TIMER(See)
     const Square from = Move2From(m);
     const Square to   = Move2To(m);
     const MType type  = Move2Type(m);
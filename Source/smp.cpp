@@ -3,11 +3,16 @@
 #include "dynamicConfig.hpp"
 #include "logging.hpp"
 #include "searcher.hpp"
+#include "skill.hpp"
 
 namespace{
     std::unique_ptr<ThreadPool> _pool = 0;
 }
 
+namespace ABDADA{
+    std::array<std::atomic<Hash>,tableSize> table = {};
+}
+
 ThreadPool & ThreadPool::instance(){ 
     if ( !_pool ) _pool.reset(new ThreadPool);
     return *_pool;
@@ -32,7 +37,12 @@ void ThreadPool::setup(){
     while (size() < DynamicConfig::threads) { // init other threads (for main see below)
        push_back(std::unique_ptr<Searcher>(new Searcher(size())));
        back()->initPawnTable();
-       back()->clearGame();
+       // main searcher is used from this thread, others fill their own tables at their first search (first touch, NUMA local pages)
+       if ( back()->isMainThread() ) back()->clearGame();
+       else{
+          back()->stats.init();
+          back()->newGamePending = true;
+       }
     }
 }
 
@@ -57,19 +67,62 @@ Move ThreadPool::search(const ThreadData & d){ // distribute data and call main
     main().search(); ///@todo 1 thread for nothing here
     stop(); // propagate stop flag to all threads
     wait();
+    if ( size() > 1 && DynamicConfig::multiPV == 1 && !Skill::enabled() && DynamicConfig::level != 0 && d.p.halfmoves >= DynamicConfig::randomPly ) selectBestThread();
     return main().getData().best;
 }
 
+void ThreadPool::selectBestThread(){
+    // stockfish like vote, each thread votes for its root move weighted by score and depth
+    ScoreType minScore = MATE;
+    for (auto & s : *this){
+        const ThreadData & td = (*s).getData();
+        if ( td.best != INVALIDMOVE && td.depth > 0 ) minScore = std::min(minScore,td.sc);
+    }
+    std::unordered_map<MiniMove,int64_t> votes;
+    for (auto & s : *this){
+        const ThreadData & td = (*s).getData();
+        if ( td.best != INVALIDMOVE && td.depth > 0 ) votes[Move2MiniMove(td.best)] += int64_t(td.sc - minScore + 14) * td.depth;
+    }
+    size_t bestId = 0;
+    for (size_t k = 1 ; k < size() ; ++k){
+        const ThreadData & td = (*this)[k]->getData();
+        const ThreadData & bd = (*this)[bestId]->getData();
+        if ( td.best == INVALIDMOVE || td.depth == 0 || td.pv.empty() ) continue;
+        if ( bd.best == INVALIDMOVE ) bestId = k;
+        else if ( isMatingScore(bd.sc) ){ if ( td.sc > bd.sc ) bestId = k; } // prefer shortest mate
+        else{
+            const int64_t tv = votes[Move2MiniMove(td.best)];
+            const int64_t bv = votes[Move2MiniMove(bd.best)];
+            if ( isMatingScore(td.sc) || (!isMatedScore(td.sc) && (tv > bv || (tv == bv && td.depth > bd.depth))) ) bestId = k;
+        }
+    }
+    if ( bestId == 0 ) return;
+    const ThreadData & bd = (*this)[bestId]->getData();
+    ThreadData & md = main().getData();
+    if ( sameMove(bd.best,md.best) && bd.depth <= md.depth ) return; // nothing better to show
+    Logging::LogIt(Logging::logInfo) << "Thread " << bestId << " selected (depth " << (int)bd.depth << ", score " << bd.sc << ") instead of main thread (depth " << (int)md.depth << ", score " << md.sc << ")";
+    md.best     = bd.best;
+    md.sc       = bd.sc;
+    md.depth    = bd.depth;
+    md.seldepth = bd.seldepth;
+    md.pv       = bd.pv;
+    main().displayGUI(md.depth,md.seldepth,md.sc,md.pv,1);
+}
+
 void ThreadPool::startOthers(){ for (auto & s : *this) if (!(*s).isMainThread()) (*s).start();}
 
 void ThreadPool::clearGame(){
-    TT::clearTT();
-    for (auto & s : *this) (*s).clearGame();
+    TT::newGame();
+    for (auto & s : *this){
+        (*s).stats.init();
+        (*s).newGamePending = true; // other tables are reset by the thread itself at next search start
+    }
 }
 
 void ThreadPool::clearSearch(){ 
     //TT::clearTT(); // to be forced for reproductible results
-    for (auto & s : *this) (*s).clearSearch();
+    Logging::LogIt(Logging::logInfo) << "Init stats";
+    for (auto & s : *this) (*s).stats.init(); // other tables are reset by each thread itself at search start
 }
 
 void ThreadPool::stop(){ for (auto & s : *this) (*s).stopFlag = true;}
@@ -78,6 +131,11 @@ void ThreadPool::DisplayStats()const{
     for(size_t k = 0 ; k < Stats::sid_maxid ; ++k){
         Logging::LogIt(Logging::logInfo) << Stats::Names[k] << " " << counter((Stats::StatId)k);
     }
+    for(DepthType d = 1 ; d < MAX_DEPTH ; ++d){
+        Counter nodes = 0, completed = 0;
+        for (auto & it : *this ){ nodes += it->stats.depthNodes[d]; completed += it->stats.depthCompleted[d]; }
+        if ( nodes ) Logging::LogIt(Logging::logInfo) << "depth " << (int)d << " nodes " << nodes << " completed " << completed << "/" << size();
+    }
 }
 
 Counter ThreadPool::counter(Stats::StatId id) const { 
@@ -29,6 +29,28 @@ struct ThreadData{
     SearchData datas;
 };
 
+/*!
+ * ABDADA like "currently searching" table (lossy and lock-free)
+ * Key is built from position hash, move and depth, threads register the move they are searching
+ * so that helper threads can defer it to the end of their own move loop
+ */
+namespace ABDADA{
+    const DepthType minDepth = 5; // do not bother with shallow nodes
+    const size_t tableSize = 1ull << 15;
+    extern std::array<std::atomic<Hash>,tableSize> table;
+
+    [[nodiscard]] inline Hash key(Hash h, Move m, DepthType d){ return h ^ (Hash(Move2MiniMove(m)) * 0x9E3779B97F4A7C15ull) ^ (Hash(d) << 56) ^ 1ull; }
+    [[nodiscard]] inline bool isSearching(Hash k){ return table[k & (tableSize-1)].load(std::memory_order_relaxed) == k; }
+
+    // register in constructor, unregister in destructor (only if still the owner of the slot)
+    struct Guard{
+        Guard(Hash k, bool active):_k(k),_active(active){ if (_active) table[_k & (tableSize-1)].store(_k,std::memory_order_relaxed); }
+        ~Guard(){ if (_active){ Hash expected = _k; table[_k & (tableSize-1)].compare_exchange_strong(expected,nullHash,std::memory_order_relaxed); } }
+        const Hash _k;
+        const bool _active;
+    };
+}
+
 /*!
  * This is the singleton pool of threads
  * The search function here is the main entry point for an analysis
@@ -44,6 +66,8 @@ public:
     void startOthers();
     void wait(bool otherOnly = false);
     void stop();
+    // Lazy SMP best thread selection (by vote), result is copied into main thread data
+    void selectBestThread();
     // gathering counter information from all threads
     [[nodiscard]] Counter counter(Stats::StatId id) const;
     void DisplayStats()const;
@@ -1,11 +1,9 @@
 #include "tables.hpp"
 
-#include "logging.hpp"
 #include "searcher.hpp"
 
 void KillerT::initKillers(){
-    Logging::LogIt(Logging::logInfo) << "Init killers" ;
-    for(int k = 0 ; k < MAX_DEPTH; ++k) for(int i = 0; i < 2; ++i) killers[k][i] = INVALIDMOVE;
+    std::fill(&killers[0][0], &killers[0][0]+MAX_DEPTH*2, INVALIDMOVE);
 }
 
 bool KillerT::isKiller(const Move m, const DepthType ply){
@@ -20,15 +18,13 @@ void KillerT::update(Move m, DepthType ply){
 }
 
 void HistoryT::initHistory(bool noCleanCounter){
-    Logging::LogIt(Logging::logInfo) << "Init history" ;
-    for(int i = 0; i < NbSquare; ++i) for(int k = 0 ; k < NbSquare; ++k) history[0][i][k] = history[1][i][k] = 0;
-    for(int i = 0; i < NbPiece; ++i) for(int k = 0 ; k < NbSquare; ++k) historyP[i][k] = 0;
-    if (!noCleanCounter) for(int i = 0; i < 13; ++i) for(int j = 0 ; j < NbSquare; ++j) for(int k = 0 ; k < NbPiece*NbSquare; ++k) counter_history[i][j][k] = -1;
+    std::memset(history,  0, sizeof(history));
+    std::memset(historyP, 0, sizeof(historyP));
+    if (!noCleanCounter) std::fill(&counter_history[0][0][0], &counter_history[0][0][0]+NbCMHPiece*NbSquare*NbCMHPiece*NbSquare, ScoreType(-1));
 }
 
 void CounterT::initCounter(){
-    Logging::LogIt(Logging::logInfo) << "Init counter" ;
-    for(int i = 0; i < NbSquare; ++i) for(int k = 0 ; k < NbSquare; ++k) counter[i][k] = 0;
+    std::memset(counter, 0, sizeof(counter));
 }
 
 void CounterT::update(Move m, const Position & p){
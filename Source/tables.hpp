@@ -18,6 +18,16 @@
 static const int MAX_CMH_PLY = 2;
 typedef std::array<ScoreType*,MAX_CMH_PLY> CMHPtrArray;
 
+// continuation history only uses the 12 real pieces (no empty row)
+const int NbCMHPiece = 2*PieceShift;
+[[nodiscard]] inline int CMHPieceIdx(Piece pp){ assert(pp != P_none); return pp < 0 ? pp + PieceShift : pp + PieceShift - 1; }
+[[nodiscard]] inline int CMHIdx(Piece pp, Square to){ return CMHPieceIdx(pp) * NbSquare + to; }
+
+// int16 history entries are updated with a gravity formula and saturated at +/- HISTORY_MAX
+inline void updateHistoryEntry(ScoreType & item, int s){
+    item = ScoreType(std::clamp(item + s - HISTORY_DIV(item * std::abs(s)), -HISTORY_MAX, HISTORY_MAX));
+}
+
 struct KillerT{
     Move killers[MAX_DEPTH][2];
 
@@ -29,7 +39,7 @@ struct KillerT{
 struct HistoryT{
     ScoreType history[2][NbSquare][NbSquare]; // Color, from, to
     ScoreType historyP[NbPiece][NbSquare]; // Piece, to
-    ScoreType counter_history[NbPiece][NbSquare][NbPiece*NbSquare]; //previous moved piece, previous to, current moved piece * boardsize + current to
+    ScoreType counter_history[NbCMHPiece][NbSquare][NbCMHPiece*NbSquare]; //previous moved piece, previous to, current moved piece * boardsize + current to (a node continuation row is contiguous)
 
     void initHistory(bool noCleanCounter = false);
 
@@ -39,15 +49,13 @@ struct HistoryT{
            const Color c = p.c;
            const Square from = Move2From(m); assert(squareOK(from));
            const Square to = Move2To(m); assert(squareOK(to));
-           const ScoreType s = S * HSCORE(depth);
+           const int s = S * HSCORE(depth);
            const Piece pp = p.board_const(from);
-           history[c][from][to] += s - HISTORY_DIV(history[c][from][to] * (int)std::abs(s));
-           historyP[pp+PieceShift][to] += s - HISTORY_DIV(historyP[pp+PieceShift][to] * (int)std::abs(s));
+           updateHistoryEntry(history[c][from][to], s);
+           updateHistoryEntry(historyP[pp+PieceShift][to], s);
+           const int cmhIdx = CMHIdx(pp,to);
            for (int i = 0; i < MAX_CMH_PLY; ++i){
-               if (cmhPtr[i]){
-                  ScoreType & item = cmhPtr[i][(p.board_const(from)+PieceShift) * NbSquare + to];
-                  item += s - HISTORY_DIV(item * (int)std::abs(s));
-               }
+               if (cmhPtr[i]) updateHistoryEntry(cmhPtr[i][cmhIdx], s);
            }
         }
     }
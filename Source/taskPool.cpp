@@ -0,0 +1,76 @@
+#include "taskPool.hpp"
+
+namespace{
+    std::unique_ptr<TaskPool> _taskPool = 0;
+    thread_local bool _inTaskPool = false;
+}
+
+TaskPool & TaskPool::instance(){
+    if ( !_taskPool ) _taskPool.reset(new TaskPool);
+    return *_taskPool;
+}
+
+TaskPool::~TaskPool(){
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _exit = true;
+    }
+    _cv.notify_all();
+    for (auto & t : _threads) t.join();
+}
+
+size_t TaskPool::grainSize(unsigned long long size, size_t nbthreads, size_t grain){
+    if ( grain ) return grain;
+    return std::max(size_t(1), size_t(size / (8*std::max(size_t(1),nbthreads)))); // a few chunks per thread for load balancing
+}
+
+void TaskPool::consume(){
+    for(;;){
+        const size_t begin = _next.fetch_add(_grain);
+        if ( begin >= _size ) break;
+        (*_job)(begin, std::min(_size, begin + _grain));
+    }
+}
+
+void TaskPool::workerLoop(){
+    _inTaskPool = true;
+    unsigned long long generation = 0;
+    std::unique_lock<std::mutex> lock(_mutex);
+    for(;;){
+        _cv.wait(lock, [&]{ return _exit || _generation != generation; });
+        if ( _exit ) return;
+        generation = _generation;
+        if ( _wanted == 0 ) continue; // enough workers already for this job
+        --_wanted;
+        lock.unlock();
+        consume();
+        lock.lock();
+        if ( --_pending == 0 ) _doneCv.notify_one();
+    }
+}
+
+void TaskPool::run(const Job & job, unsigned long long size, size_t nbthreads, size_t grain){
+    if ( size == 0 ) return;
+    nbthreads = std::min<unsigned long long>(std::max(size_t(1),nbthreads), size);
+    if ( nbthreads == 1 || _inTaskPool ){ job(0,size); return; }
+
+    const std::lock_guard<std::mutex> runLock(_runMutex);
+    while ( _threads.size() < nbthreads - 1 ) _threads.emplace_back(&TaskPool::workerLoop, this);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _job     = &job;
+        _size    = size;
+        _grain   = grainSize(size, nbthreads, grain);
+        _next    = 0;
+        _wanted  = nbthreads - 1;
+        _pending = nbthreads - 1;
+        ++_generation;
+    }
+    _cv.notify_all();
+    _inTaskPool = true;
+    consume(); // calling thread is working too
+    _inTaskPool = false;
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCv.wait(lock, [&]{ return _pending == 0; });
+    _job = nullptr;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "definition.hpp"
+
+/*!
+ * A persistent pool of worker threads for short parallel sections outside of search
+ * (TT clearing/saving/loading, Texel tuning, test suites, ...).
+ * It is not related to the search ThreadPool (smp.hpp).
+ * Work is cut into chunks that threads (the calling one included) pick dynamically from a shared counter,
+ * so that uneven chunks are balanced without spawning threads at each call.
+ * A parallel section started from inside a pool worker is run inline by the calling thread.
+ */
+class TaskPool{
+public:
+    static TaskPool & instance();
+    ~TaskPool();
+
+    typedef std::function<void(size_t,size_t)> Job;
+
+    // call worker(begin,end) on sub-ranges of [0,size[ using at most nbthreads threads
+    // grain 0 means automatic chunk size
+    template<typename F>
+    void parallel_for(unsigned long long size, F && worker, size_t nbthreads, size_t grain = 0){
+        run(Job(std::forward<F>(worker)), size, nbthreads, grain);
+    }
+
+    // worker(begin,end) returns a partial result, partial results are combined with reduce in range order
+    // so that the result does not depend on thread scheduling (init must be neutral for reduce)
+    template<typename T, typename F, typename R>
+    [[nodiscard]] T parallel_reduce(unsigned long long size, T init, F && worker, R && reduce, size_t nbthreads, size_t grain = 0){
+        grain = grainSize(size, nbthreads, grain);
+        std::vector<T> partials(size ? (size - 1) / grain + 1 : 0, init);
+        run([&](size_t begin, size_t end){ partials[begin/grain] = worker(begin,end); }, size, nbthreads, grain);
+        for (const auto & r : partials) init = reduce(init, r);
+        return init;
+    }
+
+    [[nodiscard]] static size_t grainSize(unsigned long long size, size_t nbthreads, size_t grain);
+
+private:
+    TaskPool() = default;
+    void run(const Job & job, unsigned long long size, size_t nbthreads, size_t grain);
+    void consume();
+    void workerLoop();
+
+    std::vector<std::thread> _threads;
+    std::mutex               _runMutex; // one parallel section at a time
+    std::mutex               _mutex;
+    std::condition_variable  _cv;
+    std::condition_variable  _doneCv;
+    const Job *              _job = nullptr;
+    size_t                   _size = 0;
+    size_t                   _grain = 1;
+    std::atomic<size_t>      _next {0};
+    size_t                   _wanted = 0;  // workers still to be enrolled in current job
+    size_t                   _pending = 0; // enrolled workers not done yet
+    unsigned long long       _generation = 0;
+    bool                     _exit = false;
+};
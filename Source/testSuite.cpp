@@ -2,8 +2,12 @@
 
 #ifdef WITH_TEST_SUITE
 
+#include "dynamicConfig.hpp"
+#include "hash.hpp"
 #include "logging.hpp"
 #include "positionTools.hpp"
+#include "searcher.hpp"
+#include "transposition.hpp"
 
 bool test(const std::string & option){
 
@@ -21,9 +25,38 @@ bool test(const std::string & option){
         Logging::LogIt(Logging::logInfo) << " STS";
         Logging::LogIt(Logging::logInfo) << " MEA";
         Logging::LogIt(Logging::logInfo) << " TTT";
+        Logging::LogIt(Logging::logInfo) << " TTFile";
         return 0;
     }
 
+    // a TT loaded from TTFile shall survive a new game (ucinewgame, new, ...), kept as is or reloaded (TTFileEveryGame)
+    if (option == "TTFile") {
+        const std::string fileName = "minic_test.tt";
+        Position p;
+        readFEN(startPosition,p,true);
+        const Hash h = computeHash(p);
+        Searcher & context = ThreadPool::instance().main();
+        TT::clearTT();
+        TT::setEntry(context,h,INVALIDMOVE,createHashScore(42,0),createHashScore(42,0),TT::B_exact,12);
+        if ( !TT::save(fileName) ) Logging::LogIt(Logging::logFatal) << "TTFile test : cannot save " << fileName;
+        const std::string oldFile = DynamicConfig::ttFile;
+        const bool oldEveryGame = DynamicConfig::ttFileEveryGame;
+        DynamicConfig::ttFile = fileName;
+        TT::Entry e;
+        DynamicConfig::ttFileEveryGame = false;
+        ThreadPool::instance().clearGame();
+        if ( !TT::getEntry(context,p,h,12,e) || e.s != 42 ) Logging::LogIt(Logging::logFatal) << "TTFile test : entry lost after new game";
+        TT::clearTT();
+        DynamicConfig::ttFileEveryGame = true;
+        ThreadPool::instance().clearGame();
+        if ( !TT::getEntry(context,p,h,12,e) || e.s != 42 ) Logging::LogIt(Logging::logFatal) << "TTFile test : entry not reloaded at new game";
+        DynamicConfig::ttFile = oldFile;
+        DynamicConfig::ttFileEveryGame = oldEveryGame;
+        std::remove(fileName.c_str());
+        Logging::LogIt(Logging::logInfo) << "TTFile test : ok";
+        return true;
+    }
+
     if (option == "MEA") {
         std::vector<std::string> positions;
         if ( ! readEPDFile("Book_and_Test/TestSuite/allsets_nodupes.epd",positions) ) return 1;
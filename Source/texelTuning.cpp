@@ -13,6 +13,7 @@
 #include "score.hpp"
 #include "searcher.hpp"
 #include "smp.hpp"
+#include "taskPool.hpp"
 #include "tools.hpp"
 
 namespace Texel {
@@ -77,26 +78,21 @@ double Sigmoid(Position & p) {
 }
 
 double E(const std::vector<Texel::TexelInput> &data, size_t miniBatchSize) {
-    std::atomic<double> e(0);
     static Counter count(0);
     static Counter ms(0);
-    std::mutex m;
     const bool progress = true;
     std::chrono::time_point<Clock> startTime = Clock::now();
 
-    auto worker = [&] (size_t begin, size_t end, std::atomic<double> & acc) {
+    auto worker = [&] (size_t begin, size_t end) {
       double ee = 0;
       for(auto k = begin; k != end; ++k) {
         Position * p = data[k].p.get();
         assert(p);
         ee += std::pow((data[k].result+1)*0.5 - Sigmoid(*p),2);
       }
-      {
-          const std::lock_guard<std::mutex> lock(m);
-          acc.store( acc.load() + ee );
-      }
+      return ee;
     };
-    threadedWork(worker,DynamicConfig::threads,miniBatchSize, std::ref(e));
+    const double e = TaskPool::instance().parallel_reduce(miniBatchSize, 0., worker, std::plus<double>(), DynamicConfig::threads);
 
     if ( progress ) {
         count += miniBatchSize;
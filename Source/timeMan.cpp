@@ -2,6 +2,7 @@
 
 #include "logging.hpp"
 #include "position.hpp"
+#include "searcher.hpp"
 
 namespace TimeMan{
 
@@ -10,8 +11,8 @@ TimeType targetTime, maxTime;
 DepthType moveToGo;
 unsigned long long maxNodes;
 bool isDynamic;
-bool isUCIPondering;
-bool isUCIAnalysis;
+std::atomic<bool> isUCIPondering {false};
+std::atomic<bool> isUCIAnalysis  {false};
 
 void init(){
     Logging::LogIt(Logging::logInfo) << "Init timeman" ;
@@ -89,4 +90,30 @@ TimeType GetNextMSecPerMove(const Position & p){
     maxTime = std::min(msecUntilNextTC - msecMarginMin,targetTime*7);
     return targetTime;
 }
+Watchdog::Watchdog(Searcher & searcher):_searcher(searcher),_thread(&Watchdog::run, this){}
+
+Watchdog::~Watchdog(){
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _done = true;
+    }
+    _cv.notify_one();
+    _thread.join();
+}
+
+void Watchdog::run(){
+    std::unique_lock<std::mutex> lock(_mutex);
+    while( !_done && !_searcher.stopFlag ){
+        // available time can change during search (move difficulty, ponderhit, ...) so it is read again each time
+        const TimeType elapsed = (TimeType)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - _searcher.startTime).count();
+        const TimeType remaining = _searcher.getCurrentMoveMs() - elapsed;
+        if ( remaining < 0 ){
+            _searcher.stopFlag = true;
+            Logging::LogIt(Logging::logInfo) << "stopFlag triggered by watchdog after " << elapsed << "ms";
+            break;
+        }
+        _cv.wait_for(lock, std::chrono::milliseconds(std::clamp(remaining, TimeType(1), TimeType(5))));
+    }
+}
+
 } // TimeMan
@@ -3,6 +3,7 @@
 #include "definition.hpp"
 
 struct Position;
+struct Searcher;
 
 /*!
  * Time managament in Minic
@@ -18,11 +19,29 @@ extern TimeType targetTime, maxTime;
 extern DepthType moveToGo;
 extern unsigned long long maxNodes;
 extern bool isDynamic;
-extern bool isUCIPondering;
-extern bool isUCIAnalysis;
+extern std::atomic<bool> isUCIPondering; // ponderhit changes it while searching
+extern std::atomic<bool> isUCIAnalysis;
 
 void init();
 
 [[nodiscard]] TimeType GetNextMSecPerMove(const Position & p);
 
+/*!
+ * The watchdog is a small thread living as long as a main thread search.
+ * It sets the searcher stopFlag as soon as Searcher::getCurrentMoveMs() is elapsed (using steady clock),
+ * so that time is respected whatever the search is doing (long qsearch explosion, slow host, ...).
+ */
+class Watchdog{
+public:
+    explicit Watchdog(Searcher & searcher);
+    ~Watchdog();
+private:
+    void run();
+    Searcher &              _searcher;
+    std::mutex              _mutex;
+    std::condition_variable _cv;
+    bool                    _done = false;
+    std::thread             _thread;
+};
+
 } // TimeMan
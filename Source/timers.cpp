@@ -7,30 +7,75 @@
 #ifdef _WIN32
 #include <intrin.h>
 uint64_t rdtsc(){return __rdtsc();}
-#else
+#elif defined(__x86_64__) || defined(__i386__)
 uint64_t rdtsc(){
     unsigned int lo,hi;
     __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
     return ((uint64_t)hi << 32) | lo;
 }
+#else
+uint64_t rdtsc(){ return std::chrono::steady_clock::now().time_since_epoch().count(); }
 #endif
 
 namespace Timers{
 
-uint64_t rdtscCounter[TM_Max] = {0ull};
-uint64_t callCounter [TM_Max] = {0ull};
+thread_local Slot * slot = nullptr;
+std::atomic<bool> active {false};
+std::atomic<unsigned int> sampling {1};
+
+namespace{
+std::mutex slotMutex;
+std::list<Slot> slots; // never shrinks, so that slot pointers stay valid
+uint64_t rdtscReset = rdtsc();
+}
 
-const std::string TimerNames[TM_Max] = { "Total", "See", "Apply", "Eval1", "Eval2", "Eval3", "Eval4", "Eval5", "Eval", "Attack", "MovePiece", "Generate", "PseudoLegal", "IsAttacked", "MoveScoring", "MoveSorting"};
+Slot * registerSlot(){
+    const std::lock_guard<std::mutex> lock(slotMutex);
+    slots.emplace_back();
+    return &slots.back();
+}
+
+void reset(){
+    const std::lock_guard<std::mutex> lock(slotMutex);
+    for (auto & s : slots){
+        for (TimerType tm = TM_See ; tm < TM_Max ; tm = TimerType(tm+1)){ s.rdtscCounter[tm].store(0, std::memory_order_relaxed); s.callCounter[tm].store(0, std::memory_order_relaxed); }
+    }
+    rdtscReset = rdtsc();
+    active.store(DynamicConfig::timers, std::memory_order_relaxed);
+    sampling.store(std::max(1u, DynamicConfig::timerSampling), std::memory_order_relaxed);
+}
 
-#define DisplayHelper(name) \
-    if ( callCounter[name] ) std::cout << std::left << std::setw(15) << TimerNames[tm] \
-                                       << std::right << std::setw(15) << rdtscCounter[name] << "  " \
-                                       << std::right << std::setw(15) << 100.f*rdtscCounter[name] / rdtscCounter[TM_Total] << "%  " \
-                                       << std::right << std::setw(15) << callCounter[name] << " " \
-                                       << std::right << std::setw(15) << rdtscCounter[name]/callCounter[name] << std::endl;
+const std::string TimerNames[TM_Max] = { "See", "Apply", "Eval1", "Eval2", "Eval3", "Eval4", "Eval5", "Eval", "Attack", "MovePiece", "Generate", "PseudoLegal", "IsAttacked", "MoveScoring", "MoveSorting"};
 
+// sampled counters are scaled back by TimerSampling, percentages are relative to elapsed time of all threads sampled since last reset
 void Display(){
-    for ( TimerType tm = TM_Total ; tm < TM_Max ; tm = TimerType(tm+1)) DisplayHelper(tm);
+    const std::lock_guard<std::mutex> lock(slotMutex);
+    uint64_t rdtscCounter[TM_Max] = {0ull};
+    uint64_t callCounter [TM_Max] = {0ull};
+    size_t sampledThreads = 0; // slots of threads that did not run since last reset are ignored
+    for (const auto & s : slots){
+        bool sampled = false;
+        for (TimerType tm = TM_See ; tm < TM_Max ; tm = TimerType(tm+1)){
+            rdtscCounter[tm] += s.rdtscCounter[tm].load(std::memory_order_relaxed);
+            const uint64_t calls = s.callCounter[tm].load(std::memory_order_relaxed);
+            callCounter[tm] += calls;
+            sampled |= calls != 0;
+        }
+        if ( sampled ) ++sampledThreads;
+    }
+    const uint64_t rate = sampling.load(std::memory_order_relaxed);
+    const double total = double(rdtsc() - rdtscReset) * std::max(size_t(1), sampledThreads);
+    Logging::LogIt(Logging::logInfo) << "Timers (" << sampledThreads << " threads, sampling 1/" << rate << ")";
+    for (TimerType tm = TM_See ; tm < TM_Max ; tm = TimerType(tm+1)){
+        if ( !callCounter[tm] ) continue;
+        std::stringstream ss;
+        ss << std::left << std::setw(15) << TimerNames[tm]
+           << std::right << std::setw(15) << rdtscCounter[tm]*rate << "  "
+           << std::right << std::setw(15) << 100.*rdtscCounter[tm]*rate / total << "%  "
+           << std::right << std::setw(15) << callCounter[tm]*rate << " "
+           << std::right << std::setw(15) << rdtscCounter[tm]/callCounter[tm];
+        Logging::LogIt(Logging::logInfo) << ss.str();
+    }
 }
 }
 
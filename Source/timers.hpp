@@ -2,25 +2,61 @@
 
 #include "definition.hpp"
 
+#include "dynamicConfig.hpp"
+
 /*!
  * A little instrumentation facility to study part of Minic speed
+ * Timers are switched on and off at runtime (Timers option) so that production binaries can be profiled,
+ * when activated only 1 call in TimerSampling of each timer is measured to keep overhead small
+ * (a sampling counter per timer, so that interleaved timers are all sampled according to their own call count).
+ * Timers stopped from the same START_TIMER (Eval1 ... Eval5 and Eval) share its sampling.
+ * Each thread accumulates in its own cache line padded slot, slots are only aggregated for display.
+ * Options are copied to atomics by reset (option callback), as they may change while other threads are searching.
  */
 
 #ifdef WITH_TIMER
 uint64_t rdtsc();
-#define START_TIMER uint64_t rdtscBegin = rdtsc();
-#define STOP_AND_SUM_TIMER(name) Timers::rdtscCounter[TM_##name] += rdtsc() - rdtscBegin; ++Timers::callCounter[TM_##name];
+#define START_TIMER(name) const uint64_t rdtscBegin = Timers::start(TM_##name);
+#define STOP_AND_SUM_TIMER(name) Timers::stop(TM_##name, rdtscBegin);
 
-enum TimerType : unsigned char { TM_Total=0, TM_See, TM_Apply, TM_Eval1, TM_Eval2, TM_Eval3, TM_Eval4, TM_Eval5, TM_Eval, TM_Attack, TM_MovePiece, TM_Generate, TM_PseudoLegal, TM_IsAttacked, TM_MoveScoring, TM_MoveSorting, TM_Max};
+enum TimerType : unsigned char { TM_See = 0, TM_Apply, TM_Eval1, TM_Eval2, TM_Eval3, TM_Eval4, TM_Eval5, TM_Eval, TM_Attack, TM_MovePiece, TM_Generate, TM_PseudoLegal, TM_IsAttacked, TM_MoveScoring, TM_MoveSorting, TM_Max};
 
 namespace Timers{
-extern uint64_t rdtscCounter[TM_Max];
-extern uint64_t callCounter[TM_Max];
+
+struct alignas(64) Slot{
+    std::atomic<uint64_t> rdtscCounter[TM_Max] = {};
+    std::atomic<uint64_t> callCounter [TM_Max] = {};
+    uint64_t sample[TM_Max] = {};
+};
+
+extern thread_local Slot * slot;
+Slot * registerSlot();
+
+extern std::atomic<bool> active;           // DynamicConfig::timers
+extern std::atomic<unsigned int> sampling; // DynamicConfig::timerSampling
+
+// written only by the owning thread, relaxed atomics are only there to allow concurrent display
+inline void add(std::atomic<uint64_t> & counter, uint64_t v){ counter.store(counter.load(std::memory_order_relaxed) + v, std::memory_order_relaxed); }
+
+// returns 0 if this call is not measured
+[[nodiscard]] inline uint64_t start(TimerType tm){
+    if ( !active.load(std::memory_order_relaxed) ) return 0;
+    if ( !slot ) slot = registerSlot();
+    if ( ++slot->sample[tm] < sampling.load(std::memory_order_relaxed) ) return 0;
+    slot->sample[tm] = 0;
+    return rdtsc();
+}
+
+inline void stop(TimerType tm, uint64_t begin){
+    if ( !begin || !slot ) return;
+    add(slot->rdtscCounter[tm], rdtsc() - begin);
+    add(slot->callCounter[tm], 1);
+}
+
+void reset();
 void Display();
 }
 #else
-#define START_TIMER
+#define START_TIMER(name)
 #define STOP_AND_SUM_TIMER(name)
 #endif
-
-
@@ -3,41 +3,106 @@
 #include "logging.hpp"
 #include "position.hpp"
 #include "searcher.hpp"
+#include "taskPool.hpp"
 #include "tools.hpp"
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace{
+    unsigned long long int ttSize = 0;
+    bool ttShared = false; // table is a POSIX shared memory segment (see DynamicConfig::ttSharedMemory)
+    bool ttAttached = false; // and this segment was created by another process
     template<class T>
     struct DeleteAligned{
-        void operator()(T * ptr) const { if (ptr) std_aligned_free(ptr); }
+        void operator()(T * ptr) const {
+            if (!ptr) return;
+#ifdef __linux__
+            if (ttShared){ munmap(ptr, ttSize*sizeof(T)); return; }
+#endif
+            std_aligned_free(ptr);
+        }
     };    
-    unsigned long long int ttSize = 0;
     std::unique_ptr<TT::Entry[],DeleteAligned<TT::Entry>> table(nullptr);
+
+#ifdef __linux__
+    // attach to (or create) the named segment, other processes using the same name and size share the table.
+    // Entries are XOR-verified so that concurrent writes from other processes are as safe as from other threads.
+    // The segment is never unlinked by Minic (use "rm /dev/shm/<name>" when no more needed).
+    TT::Entry * attachSharedTable(const std::string & name, bool & created){
+        const size_t size = ttSize*sizeof(TT::Entry);
+        const std::string shmName = name[0] == '/' ? name : "/" + name;
+        int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        created = fd >= 0;
+        if (created){
+            if (ftruncate(fd, size) != 0){ close(fd); shm_unlink(shmName.c_str()); return nullptr; }
+        }
+        else{
+            fd = shm_open(shmName.c_str(), O_RDWR, 0600);
+            if (fd < 0) return nullptr;
+            // the creator may not have set the size yet (a new segment is empty until ftruncate), wait for it
+            struct stat st;
+            for (int k = 0 ; k < 500 ; ++k){
+                if (fstat(fd, &st) != 0 || st.st_size != 0) break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            if (fstat(fd, &st) != 0 || (size_t)st.st_size != size){
+                Logging::LogIt(Logging::logWarn) << "Shared TT " << shmName << " exists with another size";
+                close(fd);
+                return nullptr;
+            }
+        }
+        void * ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        return ptr == MAP_FAILED ? nullptr : (TT::Entry *)ptr;
+    }
+#endif
 }
 namespace TT{
 
 GenerationType curGen = 0;
 
-#ifdef __linux__
-#include <sys/mman.h>
-#endif
-
 void initTable(){
     Logging::LogIt(Logging::logInfo) << "Init TT" ;
     Logging::LogIt(Logging::logInfo) << "Entry size " << sizeof(Entry);
+    table.reset(nullptr);
     ttSize = powerFloor((1024ull * 1024ull * DynamicConfig::ttSizeMb) / (unsigned long long int)sizeof(Entry));
     assert(countBit(ttSize) == 1); // a power of 2
+    ttShared = false;
+    ttAttached = false;
+#ifdef __linux__
+    if ( !DynamicConfig::ttSharedMemory.empty() ){
+        bool created = false;
+        Entry * shared = attachSharedTable(DynamicConfig::ttSharedMemory, created);
+        if ( shared ){
+            ttShared = true;
+            ttAttached = !created;
+            table.reset(shared);
+            Logging::LogIt(Logging::logInfo) << (created ? "Created" : "Attached to") << " shared TT " << DynamicConfig::ttSharedMemory << " of " << ttSize * sizeof(Entry) / 1024 / 1024 << "Mb" ;
+            loadFile(); // a new segment is zero filled, which is an empty table (an attached one is not loaded)
+            return;
+        }
+        Logging::LogIt(Logging::logWarn) << "Cannot use shared TT " << DynamicConfig::ttSharedMemory << ", using a private one";
+    }
+#endif
     table.reset((Entry *) std_aligned_alloc(1024,ttSize*sizeof(Entry)));
     Logging::LogIt(Logging::logInfo) << "Size of TT " << ttSize * sizeof(Entry) / 1024 / 1024 << "Mb" ;
     clearTT();
+    loadFile();
 }
 
 void clearTT() {
     TT::curGen = 0;
+    if ( ttShared && table ){ Logging::LogIt(Logging::logInfo) << "Shared TT is not cleared"; return; } // other processes are using it
     Logging::LogIt(Logging::logInfo) << "Now zeroing memory using " << DynamicConfig::threads << " threads" ;
     auto worker = [&] (size_t begin, size_t end){
        std::fill(&table[0]+begin,&table[0]+end,Entry());
     };
-    threadedWork(worker,DynamicConfig::threads,ttSize);
+    TaskPool::instance().parallel_for(ttSize,worker,DynamicConfig::threads);
     Logging::LogIt(Logging::logInfo) << "... done ";    
 }
 
@@ -117,6 +182,112 @@ void getPV(const Position & p, Searcher & context, PVList & pv){
     }
 }
 
+namespace{
+    // TT file header, entryVersion must be increased each time Entry layout changes
+    const uint32_t entryVersion = 1;
+    struct FileHeader{
+        uint32_t magic     = 0x4D545454; // "MTTT"
+        uint32_t version   = entryVersion;
+        uint32_t entrySize = sizeof(Entry);
+        uint32_t generation= 0;
+        uint64_t entries   = 0;
+    };
+    const size_t ioChunk = (64ull * 1024ull * 1024ull) / sizeof(Entry); // in entries
+}
+
+// each thread writes (or reads) its own part of the table using large sequential I/O
+bool save(const std::string & fileName){
+    FileHeader header;
+    header.generation = curGen;
+    header.entries = ttSize;
+    {
+        std::ofstream str(fileName, std::ios::binary | std::ios::trunc);
+        if (!str){
+            Logging::LogIt(Logging::logError) << "Cannot open " << fileName;
+            return false;
+        }
+        str.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+        str.seekp(sizeof(FileHeader) + ttSize*sizeof(Entry) - 1);
+        str.put(0); // set file size so that threads can write anywhere
+        if (!str) return false;
+    }
+    Logging::LogIt(Logging::logInfo) << "Saving TT to " << fileName << " (min depth " << DynamicConfig::ttSaveMinDepth << ")";
+    std::atomic<bool> ok {true};
+    std::atomic<unsigned long long> saved {0};
+    auto worker = [&] (size_t begin, size_t end){
+        std::fstream str(fileName, std::ios::binary | std::ios::in | std::ios::out);
+        str.seekp(sizeof(FileHeader) + begin*sizeof(Entry));
+        std::vector<Entry> buffer(std::min(ioChunk, end-begin));
+        unsigned long long count = 0;
+        for (size_t k = begin ; k < end && str ; k += buffer.size()){
+            const size_t n = std::min(buffer.size(), end-k);
+            std::copy(&table[0]+k, &table[0]+k+n, buffer.begin());
+            for (size_t i = 0 ; i < n ; ++i){
+                if ( buffer[i].h == nullHash ) continue;
+                if ( buffer[i].d < DynamicConfig::ttSaveMinDepth ) buffer[i] = Entry();
+                else ++count;
+            }
+            str.write(reinterpret_cast<const char*>(buffer.data()), n*sizeof(Entry));
+        }
+        if (!str) ok = false;
+        saved += count;
+    };
+    TaskPool::instance().parallel_for(ttSize,worker,DynamicConfig::threads,(ttSize+DynamicConfig::threads-1)/DynamicConfig::threads); // one file stream per thread
+    if (ok) Logging::LogIt(Logging::logInfo) << "... done, " << saved << " entries saved";
+    else    Logging::LogIt(Logging::logError) << "Error writing " << fileName;
+    return ok;
+}
+
+bool load(const std::string & fileName){
+    FileHeader header;
+    {
+        std::ifstream str(fileName, std::ios::binary);
+        if (!str){
+            Logging::LogIt(Logging::logError) << "Cannot open " << fileName;
+            return false;
+        }
+        str.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+        const FileHeader expected;
+        if (!str || header.magic != expected.magic || header.version != expected.version || header.entrySize != expected.entrySize){
+            Logging::LogIt(Logging::logError) << "Incompatible TT file " << fileName;
+            return false;
+        }
+        if (header.entries != ttSize){
+            Logging::LogIt(Logging::logError) << "TT file " << fileName << " was saved with a " << header.entries * sizeof(Entry) / 1024 / 1024 << "Mb hash, please use the same Hash size";
+            return false;
+        }
+    }
+    Logging::LogIt(Logging::logInfo) << "Loading TT from " << fileName;
+    std::atomic<bool> ok {true};
+    auto worker = [&] (size_t begin, size_t end){
+        std::ifstream str(fileName, std::ios::binary);
+        str.seekg(sizeof(FileHeader) + begin*sizeof(Entry));
+        for (size_t k = begin ; k < end && str ; k += ioChunk) str.read(reinterpret_cast<char*>(&table[0]+k), std::min(ioChunk, end-k)*sizeof(Entry));
+        if (!str) ok = false;
+    };
+    TaskPool::instance().parallel_for(ttSize,worker,DynamicConfig::threads,(ttSize+DynamicConfig::threads-1)/DynamicConfig::threads); // one file stream per thread
+    if (!ok){
+        Logging::LogIt(Logging::logError) << "TT file " << fileName << " is truncated";
+        clearTT();
+        return false;
+    }
+    curGen = header.generation;
+    Logging::LogIt(Logging::logInfo) << "... done";
+    return true;
+}
+
+void loadFile(){
+    if ( DynamicConfig::ttFile.empty() ) return;
+    if ( ttAttached ){ Logging::LogIt(Logging::logInfo) << "Shared TT is used by other processes, " << DynamicConfig::ttFile << " is not loaded"; return; }
+    load(DynamicConfig::ttFile);
+}
+
+void newGame(){
+    if ( DynamicConfig::ttFile.empty() || ttShared ) clearTT(); // a shared table is left as is by clearTT
+    else if ( DynamicConfig::ttFileEveryGame ){ clearTT(); loadFile(); } // opt-in, never on a table other processes are using
+    else Logging::LogIt(Logging::logInfo) << "TT loaded from " << DynamicConfig::ttFile << " is kept";
+}
+
 } // TT
 
 ScoreType createHashScore(ScoreType score, DepthType ply){
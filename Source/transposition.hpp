@@ -67,6 +67,14 @@ void setEntry(Searcher & context, Hash h, Move m, ScoreType s, ScoreType eval, B
 
 void getPV(const Position & p, Searcher & context, PVList & pv);
 
+// TT dump to disk (only entries with depth >= DynamicConfig::ttSaveMinDepth are kept), can only be reloaded with the same Hash size
+bool save(const std::string & fileName);
+bool load(const std::string & fileName);
+// load DynamicConfig::ttFile if any (at startup, after a table re-allocation or when the option changes)
+void loadFile();
+// for a new game : the table is cleared, or kept if a TT file is used (see DynamicConfig::ttFileEveryGame)
+void newGame();
+
 } // TT
 
 [[nodiscard]] ScoreType createHashScore(ScoreType score, DepthType ply);
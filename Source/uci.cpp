@@ -6,12 +6,14 @@
 #include "position.hpp"
 #include "searcher.hpp"
 #include "timeMan.hpp"
+#include "timers.hpp"
 #include "tools.hpp"
 
 namespace UCI {
 
     void init() {
         Logging::ct = Logging::CT_uci;
+        Logging::startAsync();
         Logging::LogIt(Logging::logInfo) << "Init uci";
         COM::init();
     }
@@ -140,6 +142,14 @@ namespace UCI {
                 if (!ThreadPool::instance().main().stopFlag) { Logging::LogIt(Logging::logGUI) << "info string " << uciCommand << " received but search in progress ..."; }
                 else { COM::init(); }
             }
+            else if (uciCommand == "savett" || uciCommand == "loadtt") {
+                std::string fileName = DynamicConfig::ttFile;
+                iss >> fileName;
+                if (!ThreadPool::instance().main().stopFlag) { Logging::LogIt(Logging::logGUI) << "info string " << uciCommand << " received but search in progress ..."; }
+                else if (fileName.empty()) { Logging::LogIt(Logging::logGUI) << "info string " << uciCommand << " needs a file name (or TTFile option)"; }
+                else if (uciCommand == "savett") { TT::save(fileName); }
+                else { TT::load(fileName); }
+            }
             else if (uciCommand == "eval") { Logging::LogIt(Logging::logGUI) << "info string " << uciCommand << " not implemented yet"; }
             else if (uciCommand == "tbprobe") {
                 std::string type;
@@ -147,9 +157,13 @@ namespace UCI {
                 Logging::LogIt(Logging::logGUI) << "info string " << uciCommand << " not implemented yet";
             }
             else if (uciCommand == "print") { Logging::LogIt(Logging::logInfo) << ToString(COM::position); }
+#ifdef WITH_TIMER
+            else if (uciCommand == "timers") { Timers::Display(); }
+#endif
             else if (uciCommand == "quit") {
                 COM::stopPonder();
                 COM::stop();
+                Logging::flush(); // _exit does not run atexit handlers
                 _exit(0);
             }
             else if (!uciCommand.empty()) { Logging::LogIt(Logging::logGUI) << "info string unrecognised command " << uciCommand; }
@@ -14,6 +14,7 @@ namespace XBoard{
 
     void init(){
         Logging::ct = Logging::CT_xboard;
+        Logging::startAsync();
         Logging::LogIt(Logging::logInfo) << "Init xboard" ;
         COM::init();
         display = false;
@@ -59,7 +59,7 @@ OPT="-s -DNDEBUG -O3 $n" ; DEPTH=16
 #OPT="-DNDEBUG -g" ; DEPTH=10
 #OPT="-g -rdynamic" ; DEPTH=10
 
-LIBS="-lpthread -ldl"
+LIBS="-lpthread -ldl -lrt"
 
 OPT="$WARN $d $OPT $t --std=c++17 -fno-exceptions"
 
@@ -79,6 +79,18 @@ if [ $FATHOM_PRESENT = "1" ]; then
    OPT="$OPT $dir/Fathom/src/$lib -I$dir/Fathom/src"
 fi
 
+# embed a default net inside the binary (NNUEFile option still overrides it), for instance EMBEDDEDNNUE=Tourney/nn.bin Tools/build.sh
+# the assembler includes it (incbin) in read-only data, a net with a header is used in place without copy
+if [ -n "$EMBEDDEDNNUE" ]; then
+   if [ -e "$EMBEDDEDNNUE" ]; then
+      echo "embedding NNUE net $EMBEDDEDNNUE"
+      OPT="$OPT -DEMBEDDEDNNUEPATH=\"$(readlink -f $EMBEDDEDNNUE)\""
+   else
+      echo "cannot find NNUE net to embed $EMBEDDEDNNUE"
+      exit 1
+   fi
+fi
+
 echo $OPT $LIBS
 
 rm -f *.gcda